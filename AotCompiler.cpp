@@ -0,0 +1,390 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+// chip8_aot: translates the reachable code of a ROM into a C++ translation unit implementing it against the Chip8
+// state. Link the output into an interpreter build and select the 'aot' dispatch mode to run it.
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const unsigned int START_ADDRESS = 0x200;
+static const unsigned int MEMORY_SIZE = 4096;
+static const unsigned int MAX_BLOCK_INSTRUCTIONS = 64;
+
+enum class Flow {
+    Next,       // Falls through to the next instruction
+    Jump,       // 1nnn
+    Call,       // 2nnn
+    Return,     // 00EE
+    Skip,       // 3xkk, 4xkk, 5xy0, 9xy0, Ex9E, ExA1
+    Computed,   // Bnnn
+    KeyWait,    // Fx0A, repeats itself until a key is pressed
+    Write       // Fx33, Fx55, may modify code
+};
+
+struct Instruction {
+    Flow flow;
+    string code;        // C++ statement, empty for opcodes that do nothing
+    bool readsPc;       // Needs the real pc before it runs
+    bool setsPc;        // Overwrites pc
+    bool readsCycles;   // Needs the real cycle count before it runs: timers, and key reads and draws for latency tracing
+};
+
+static string hex(unsigned int value, int digits = 1) {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "0x%0*X", digits, value);
+    return buffer;
+}
+
+// Must decode exactly like Chip8::opcode_translation
+static Instruction Translate(uint16_t opcode) {
+    string x = hex((opcode & 0x0F00u) >> 8u);
+    string y = hex((opcode & 0x00F0u) >> 4u);
+    string kk = hex(opcode & 0x00FFu, 2);
+    string n = hex(opcode & 0x000Fu);
+    string nnn = hex(opcode & 0x0FFFu, 3);
+
+    Instruction i{Flow::Next, "", false, false, false};
+
+    switch (opcode >> 12u) {
+        case 0x0:
+            switch (opcode & 0x000Fu) {
+                case 0x0: i = {Flow::Next, "OP_00E0(c);", false, false, true}; break;
+                case 0xE: i = {Flow::Return, "OP_00EE(c);", false, true, false}; break;
+                default: break;
+            }
+            break;
+        case 0x1: i = {Flow::Jump, "OP_1nnn(c, " + nnn + ");", false, true, false}; break;
+        case 0x2: i = {Flow::Call, "OP_2nnn(c, " + nnn + ");", true, true, false}; break;
+        case 0x3: i = {Flow::Skip, "OP_3xkk(c, " + x + ", " + kk + ");", true, false, false}; break;
+        case 0x4: i = {Flow::Skip, "OP_4xkk(c, " + x + ", " + kk + ");", true, false, false}; break;
+        case 0x5: i = {Flow::Skip, "OP_5xy0(c, " + x + ", " + y + ");", true, false, false}; break;
+        case 0x6: i.code = "OP_6xkk(c, " + x + ", " + kk + ");"; break;
+        case 0x7: i.code = "OP_7xkk(c, " + x + ", " + kk + ");"; break;
+        case 0x8:
+            switch (opcode & 0x000Fu) {
+                case 0x0: i.code = "OP_8xy0(c, " + x + ", " + y + ");"; break;
+                case 0x1: i.code = "OP_8xy1(c, " + x + ", " + y + ");"; break;
+                case 0x2: i.code = "OP_8xy2(c, " + x + ", " + y + ");"; break;
+                case 0x3: i.code = "OP_8xy3(c, " + x + ", " + y + ");"; break;
+                case 0x4: i.code = "OP_8xy4(c, " + x + ", " + y + ");"; break;
+                case 0x5: i.code = "OP_8xy5(c, " + x + ", " + y + ");"; break;
+                case 0x6: i.code = "OP_8xy6(c, " + x + ");"; break;
+                case 0x7: i.code = "OP_8xy7(c, " + x + ", " + y + ");"; break;
+                case 0xE: i.code = "OP_8xyE(c, " + x + ");"; break;
+                default: break;
+            }
+            break;
+        case 0x9: i = {Flow::Skip, "OP_9xy0(c, " + x + ", " + y + ");", true, false, false}; break;
+        case 0xA: i.code = "OP_Annn(c, " + nnn + ");"; break;
+        case 0xB: i = {Flow::Computed, "OP_Bnnn(c, " + nnn + ");", false, true, false}; break;
+        case 0xC: i.code = "OP_Cxkk(c, " + x + ", " + kk + ");"; break;
+        case 0xD: i = {Flow::Next, "OP_Dxyn(c, " + x + ", " + y + ", " + n + ");", false, false, true}; break;
+        case 0xE:
+            switch (opcode & 0x000Fu) {
+                case 0x1: i = {Flow::Skip, "OP_ExA1(c, " + x + ");", true, false, true}; break;
+                case 0xE: i = {Flow::Skip, "OP_Ex9E(c, " + x + ");", true, false, true}; break;
+                default: break;
+            }
+            break;
+        default:
+            switch (opcode & 0x00FFu) {
+                case 0x07: i = {Flow::Next, "OP_Fx07(c, " + x + ");", false, false, true}; break;
+                case 0x0A: i = {Flow::KeyWait, "OP_Fx0A(c, " + x + ");", true, false, true}; break;
+                case 0x15: i = {Flow::Next, "OP_Fx15(c, " + x + ");", false, false, true}; break;
+                case 0x18: i = {Flow::Next, "OP_Fx18(c, " + x + ");", false, false, true}; break;
+                case 0x1E: i.code = "OP_Fx1E(c, " + x + ");"; break;
+                case 0x29: i.code = "OP_Fx29(c, " + x + ");"; break;
+                case 0x33: i.flow = Flow::Write; i.code = "OP_Fx33(c, " + x + ");"; break;
+                case 0x55: i.flow = Flow::Write; i.code = "OP_Fx55(c, " + x + ");"; break;
+                case 0x65: i.code = "OP_Fx65(c, " + x + ");"; break;
+                default: break;
+            }
+            break;
+    }
+
+    return i;
+}
+
+class Recompiler {
+public:
+    explicit Recompiler(vector<uint8_t> const &rom) : memory(MEMORY_SIZE, 0) {
+        std::copy(rom.begin(), rom.end(), memory.begin() + START_ADDRESS);
+        imageSize = rom.size();
+    }
+
+    void Discover() {
+        vector<uint16_t> work{START_ADDRESS};
+        leaders.insert(START_ADDRESS);
+
+        while (!work.empty()) {
+            uint16_t address = work.back();
+            work.pop_back();
+
+            // Instructions must fit in memory without wrapping
+            if (address + 1u >= MEMORY_SIZE || !reachable.insert(address).second) {
+                continue;
+            }
+
+            uint16_t opcode = Opcode(address);
+            uint16_t target = opcode & 0x0FFFu;
+            uint16_t next = address + 2;
+
+            switch (Translate(opcode).flow) {
+                case Flow::Next:
+                    work.push_back(next);
+                    break;
+                case Flow::Jump:
+                    Lead(target, work);
+                    break;
+                case Flow::Call:
+                    Lead(target, work);
+                    Lead(next, work);
+                    break;
+                case Flow::Return:
+                case Flow::Computed:
+                    break;
+                case Flow::Skip:
+                    Lead(next, work);
+                    Lead(next + 2, work);
+                    break;
+                case Flow::KeyWait:
+                    leaders.insert(address);
+                    Lead(next, work);
+                    break;
+                case Flow::Write:
+                    Lead(next, work);
+                    break;
+            }
+        }
+
+        // Split at leaders, at reachable code only entered by fall-through, and every MAX_BLOCK_INSTRUCTIONS
+        for (bool changed = true; changed;) {
+            changed = false;
+            blocks.clear();
+
+            for (uint16_t leader: leaders) {
+                if (!reachable.count(leader)) {
+                    continue;
+                }
+
+                uint16_t address = leader;
+                unsigned int count = 0;
+                while (true) {
+                    Flow flow = Translate(Opcode(address)).flow;
+                    address += 2;
+                    ++count;
+
+                    if (flow != Flow::Next || leaders.count(address) || !reachable.count(address)) {
+                        break;
+                    }
+                    if (count == MAX_BLOCK_INSTRUCTIONS) {
+                        changed |= leaders.insert(address).second;
+                        break;
+                    }
+                }
+                blocks[leader] = address - leader;
+            }
+        }
+    }
+
+    string Generate(string const &name) {
+        ostringstream out;
+
+        out << "// Generated by chip8_aot from " << name << ", do not edit.\n\n";
+        out << "#include \"AotRuntime.h\"\n#include \"Instructions.h\"\n\nusing namespace Instructions;\n\n";
+
+        out << "static const uint8_t image[] = {";
+        for (size_t i = 0; i < imageSize; ++i) {
+            out << (i % 16 ? " " : "\n        ") << hex(memory[START_ADDRESS + i], 2) << ",";
+        }
+        out << "\n};\n\n";
+
+        out << "static const uint16_t block_starts[] = {";
+        size_t column = 0;
+        for (auto const &block: blocks) {
+            out << (column++ % 12 ? " " : "\n        ") << hex(block.first, 3) << ",";
+        }
+        out << "\n};\n\n";
+
+        out << "static const uint16_t block_sizes[] = {";
+        column = 0;
+        for (auto const &block: blocks) {
+            out << (column++ % 16 ? " " : "\n        ") << block.second << ",";
+        }
+        out << "\n};\n\n";
+
+        map<uint16_t, size_t> ids;
+        for (auto const &block: blocks) {
+            ids.emplace(block.first, ids.size());
+        }
+        auto jumpTo = [&ids](uint16_t address) {
+            auto id = ids.find(address);
+            return id == ids.end() ? string("goto dispatch;") : "goto block_" + to_string(id->second) + ";";
+        };
+
+        out << "static void Run(Chip8 &c, AotState &s) {\n";
+        out << "    dispatch:\n";
+        out << "    switch (c.pc) {\n";
+        for (auto const &id: ids) {
+            out << "        case " << hex(id.first, 3) << ": goto block_" << id.second << ";\n";
+        }
+        out << "        default: return;\n";
+        out << "    }\n";
+
+        for (auto const &block: blocks) {
+            uint16_t start = block.first;
+            size_t id = ids[start];
+            unsigned int count = block.second / 2;
+
+            out << "\n    block_" << id << ": // " << hex(start, 3) << "\n";
+            out << "    if (s.remaining < " << count << " || s.dirty[" << id << "]) return;\n";
+            out << "    s.remaining -= " << count << ";\n";
+
+            // pc and cycle_count are only brought up to date where an instruction observes them
+            unsigned int pendingPc = 0;
+            unsigned int pendingCycles = 0;
+            Instruction last{};
+            uint16_t address = start;
+
+            for (unsigned int i = 0; i < count; ++i, address += 2) {
+                uint16_t opcode = Opcode(address);
+                Instruction instruction = Translate(opcode);
+                pendingPc += 2;
+
+                if (instruction.readsPc && pendingPc) {
+                    out << "    c.pc += " << pendingPc << ";\n";
+                    pendingPc = 0;
+                }
+                if (instruction.readsCycles && pendingCycles) {
+                    out << "    c.cycle_count += " << pendingCycles << ";\n";
+                    pendingCycles = 0;
+                }
+                if (instruction.setsPc) {
+                    pendingPc = 0;
+                }
+                out << "    " << (instruction.code.empty() ? "" : instruction.code + " ")
+                    << "// " << hex(address, 3) << ": " << hex(opcode, 4) << "\n";
+                ++pendingCycles;
+                last = instruction;
+            }
+
+            if (pendingPc) {
+                out << "    c.pc += " << pendingPc << ";\n";
+            }
+            out << "    c.cycle_count += " << pendingCycles << ";\n";
+
+            uint16_t lastAddress = address - 2;
+            uint16_t lastTarget = Opcode(lastAddress) & 0x0FFFu;
+            switch (last.flow) {
+                case Flow::Next:
+                    out << "    " << jumpTo(address) << "\n";
+                    break;
+                case Flow::Jump:
+                case Flow::Call:
+                    out << "    " << jumpTo(lastTarget) << "\n";
+                    break;
+                case Flow::Skip:
+                    out << "    if (c.pc == " << hex(address + 2, 3) << ") " << jumpTo(address + 2) << "\n";
+                    out << "    " << jumpTo(address) << "\n";
+                    break;
+                case Flow::KeyWait:
+                    out << "    if (c.pc == " << hex(lastAddress, 3) << ") " << jumpTo(lastAddress) << "\n";
+                    out << "    " << jumpTo(address) << "\n";
+                    break;
+                case Flow::Write:
+                    // Re-dispatch so a write into the next block is seen
+                case Flow::Return:
+                case Flow::Computed:
+                    out << "    goto dispatch;\n";
+                    break;
+            }
+        }
+
+        out << "}\n\n";
+
+        out << "static const AotProgram program = {\n";
+        out << "        \"" << name << "\",\n";
+        out << "        image, sizeof(image),\n";
+        out << "        block_starts, block_sizes, " << blocks.size() << ",\n";
+        out << "        Run\n";
+        out << "};\n\n";
+        out << "static bool registered = AotProgram::Register(&program);\n";
+
+        return out.str();
+    }
+
+    size_t BlockCount() const { return blocks.size(); }
+
+    size_t InstructionCount() const { return reachable.size(); }
+
+private:
+    uint16_t Opcode(uint16_t address) const {
+        return (memory[address] << 8u) | memory[address + 1];
+    }
+
+    void Lead(uint16_t address, vector<uint16_t> &work) {
+        leaders.insert(address);
+        work.push_back(address);
+    }
+
+    vector<uint8_t> memory;
+    size_t imageSize;
+    set<uint16_t> reachable;
+    set<uint16_t> leaders;
+    map<uint16_t, uint16_t> blocks; // start -> size in bytes
+};
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <ROM> <Output.cpp>\n";
+        return EXIT_FAILURE;
+    }
+
+    ifstream rom_file(argv[1], ios::binary);
+    if (!rom_file.is_open()) {
+        std::cerr << "Cannot open " << argv[1] << "\n";
+        return EXIT_FAILURE;
+    }
+    vector<uint8_t> rom((istreambuf_iterator<char>(rom_file)), istreambuf_iterator<char>());
+    if (rom.size() > MEMORY_SIZE - START_ADDRESS) {
+        std::cerr << argv[1] << " does not fit in memory\n";
+        return EXIT_FAILURE;
+    }
+
+    string name = argv[1];
+    size_t slash = name.find_last_of("/\\");
+    if (slash != string::npos) {
+        name = name.substr(slash + 1);
+    }
+    for (char &ch: name) {
+        if (ch == '"' || ch == '\\') {
+            ch = '_';
+        }
+    }
+
+    Recompiler recompiler(rom);
+    recompiler.Discover();
+
+    ofstream output(argv[2]);
+    output << recompiler.Generate(name);
+    if (!output) {
+        std::cerr << "Cannot write " << argv[2] << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << name << ": " << recompiler.InstructionCount() << " instructions in " << recompiler.BlockCount()
+              << " blocks\n";
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,90 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "AotRuntime.h"
+#include <algorithm>
+
+AotProgram const *AotProgram::registered = nullptr;
+
+bool AotProgram::Register(AotProgram const *program) {
+    registered = program;
+    return true;
+}
+
+AotRunner::AotRunner(Chip8 const &c) {
+    Reset(c);
+}
+
+// Only run a block compiled while memory holds the code it was compiled from
+void AotRunner::Reset(Chip8 const &c) {
+    program = AotProgram::registered;
+    dirty.clear();
+    if (!program || c.START_ADDRESS + program->image_size > PagedMemory::SIZE) {
+        program = nullptr;
+        return;
+    }
+
+    dirty.assign(program->block_count, 0);
+    for (size_t block = 0; block < program->block_count; ++block) {
+        uint16_t start = program->block_starts[block];
+        for (uint16_t i = 0; i < program->block_sizes[block] && !dirty[block]; ++i) {
+            uint16_t address = start + i;
+            // Memory below the image wasn't compiled against; past it the compiler saw zeros
+            uint8_t compiled = 0;
+            if (address < c.START_ADDRESS) {
+                dirty[block] = 1;
+                break;
+            }
+            if (address - c.START_ADDRESS < program->image_size) {
+                compiled = program->image[address - c.START_ADDRESS];
+            }
+            dirty[block] = c.memory.Read(address) != compiled;
+        }
+    }
+}
+
+void AotRunner::Run(Chip8 &c, unsigned int cycles) {
+    if (!program) {
+        for (unsigned int i = 0; i < cycles; ++i) {
+            c.Cycle();
+        }
+        return;
+    }
+
+    AotState state{};
+    state.dirty = dirty.data();
+
+    while (cycles > 0) {
+        state.remaining = cycles;
+        program->run(c, state);
+        cycles = state.remaining;
+
+        // Compiled code gave up at the current pc, step it in the interpreter
+        if (cycles > 0) {
+            c.Cycle();
+            --cycles;
+        }
+    }
+}
+
+void AotRunner::Invalidate(uint16_t address, uint16_t length) {
+    if (!program) {
+        return;
+    }
+
+    uint16_t const *starts = program->block_starts;
+    uint16_t const *end = starts + program->block_count;
+
+    for (uint16_t i = 0; i < length; ++i) {
+        uint16_t written = (address + i) & 0x0FFFu;
+        uint16_t first = written >= MAX_BLOCK_BYTES ? written - MAX_BLOCK_BYTES : 0;
+
+        for (uint16_t const *start = std::lower_bound(starts, end, first); start != end && *start <= written; ++start) {
+            size_t block = start - starts;
+            if (written < *start + program->block_sizes[block]) {
+                dirty[block] = 1;
+            }
+        }
+    }
+}
@@ -0,0 +1,54 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_AOTRUNTIME_H
+#define CHIP8_INTERPRETER_AOTRUNTIME_H
+
+#include "Chip8.h"
+
+// Shared between a ROM compiled by chip8_aot and the runner driving it
+struct AotState {
+    unsigned int remaining; // instructions left in this slice
+    uint8_t const *dirty;   // per block, set once guest code wrote into it
+};
+
+typedef void (*AotEntry)(Chip8 &c, AotState &state);
+
+// A ROM translated to C++ by chip8_aot. The generated translation unit registers itself at startup.
+struct AotProgram {
+    char const *name;
+    uint8_t const *image;       // memory from START_ADDRESS on, as the program was compiled against
+    uint16_t image_size;
+    uint16_t const *block_starts; // sorted
+    uint16_t const *block_sizes;  // in bytes
+    uint16_t block_count;
+    // Runs compiled blocks from pc until the slice is used up or control reaches code it cannot run
+    AotEntry run;
+
+    static AotProgram const *registered;
+
+    static bool Register(AotProgram const *program);
+};
+
+// Runs the registered program, falling back to Chip8::Cycle() for computed jumps to unknown addresses, code
+// that was never discovered, and blocks whose bytes differ from the ones compiled: written by the guest, or from
+// another ROM
+class AotRunner {
+public:
+    static const unsigned int MAX_BLOCK_BYTES = 128;
+
+    explicit AotRunner(Chip8 const &c);
+
+    // Memory was replaced as a whole, by LoadImage() or ForkFrom(): compare every block again
+    void Reset(Chip8 const &c);
+
+    void Run(Chip8 &c, unsigned int cycles);
+
+    void Invalidate(uint16_t address, uint16_t length);
+
+    AotProgram const *program;
+    vector<uint8_t> dirty;
+};
+
+#endif //CHIP8_INTERPRETER_AOTRUNTIME_H
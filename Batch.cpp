@@ -0,0 +1,259 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+// chip8_batch: runs every job of a manifest headless, spread over all cores, and writes one result line per job.
+//
+// Manifest: one job per line, tab-separated: <ROM> <Seed> <Script|-> <Frames>. Blank lines and lines starting
+// with # are skipped. Relative script paths are taken from the manifest's directory.
+// Script: one key event per line: <Frame> <Key> down|up, with the key as a hex digit. Events apply at the start of
+// their frame, before its instructions run. Blank lines and lines starting with # are skipped.
+// Results: tab-separated <Job> <ROM> <Seed> <Frames> <Instructions> <Seconds> <Framebuffer>, in manifest order.
+// Instructions are the emulated ones, Frames times CyclesPerFrame: idle loops and key waits are skipped over
+// rather than executed.
+
+#include "Chip8.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+struct ScriptEvent {
+    uint64_t frame;
+    uint8_t key;
+    bool pressed;
+};
+
+struct BatchJob {
+    string rom;
+    uint64_t seed;
+    string script;
+    uint64_t frames;
+    PagedMemory const *image;
+    vector<ScriptEvent> const *events;
+};
+
+struct BatchResult {
+    uint64_t instructions;
+    double seconds;
+    uint64_t framebuffer;
+};
+
+static bool ReadFile(string const &filename, vector<uint8_t> &data) {
+    ifstream file(filename, ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    data.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    return true;
+}
+
+static bool ReadScript(string const &filename, vector<ScriptEvent> &events) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Can't read input script " << filename << "\n";
+        return false;
+    }
+
+    string line;
+    for (unsigned int number = 1; getline(file, line); ++number) {
+        istringstream fields(line);
+        string frame, key, action, extra;
+        if (!(fields >> frame) || frame[0] == '#') {
+            continue;
+        }
+        uint64_t frameNumber;
+        fields >> key >> action;
+        if (!ParseCount(frame, frameNumber) || key.size() != 1 || !isxdigit(static_cast<unsigned char>(key[0])) ||
+            (action != "down" && action != "up") || fields >> extra) {
+            std::cerr << filename << ":" << number << ": expected <Frame> <Key> down|up\n";
+            return false;
+        }
+        events.push_back({frameNumber, static_cast<uint8_t>(stoi(key, nullptr, 16)), action == "down"});
+    }
+
+    stable_sort(events.begin(), events.end(), [](ScriptEvent const &a, ScriptEvent const &b) {
+        return a.frame < b.frame;
+    });
+    return true;
+}
+
+static bool ReadManifest(string const &filename, vector<BatchJob> &jobs) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Can't open manifest " << filename << "\n";
+        return false;
+    }
+
+    string line;
+    for (unsigned int number = 1; getline(file, line); ++number) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        // ROM paths may contain spaces, so fields are split on tabs only
+        vector<string> fields;
+        istringstream stream(line);
+        for (string field; getline(stream, field, '\t');) {
+            fields.push_back(field);
+        }
+        uint64_t seed;
+        uint64_t frames;
+        if (fields.size() != 4 || !ParseSeed(fields[1], seed) || !ParseCount(fields[3], frames)) {
+            std::cerr << filename << ":" << number << ": expected <ROM> <Seed> <Script|-> <Frames>\n";
+            return false;
+        }
+
+        string script = fields[2];
+        if (script != "-") {
+            script = (filesystem::path(filename).parent_path() / script).string();
+        }
+        jobs.push_back({fields[0], seed, script, frames, nullptr, nullptr});
+    }
+    return true;
+}
+
+static BatchResult RunJob(BatchJob const &job, unsigned int cyclesPerFrame, DispatchMode mode) {
+    auto start = std::chrono::steady_clock::now();
+
+    Chip8 chip8;
+    chip8.dispatch_mode = mode;
+    chip8.skip_idle_loops = true;
+    chip8.Seed(job.seed);
+    chip8.LoadImage(*job.image);
+    chip8.SetClockRate(cyclesPerFrame * chip8.FRAME_RATE);
+
+    vector<ScriptEvent> const &events = *job.events;
+    size_t next = 0;
+    for (uint64_t frame = 0; frame < job.frames; ++frame) {
+        for (; next < events.size() && events[next].frame <= frame; ++next) {
+            if (events[next].pressed) {
+                chip8.keypad.fetch_or(1u << events[next].key, memory_order_relaxed);
+            } else {
+                chip8.keypad.fetch_and(~(1u << events[next].key), memory_order_relaxed);
+            }
+        }
+
+        // A key wait with nothing held can only end on a later script event: skip the spinning
+        if (chip8.WaitingForKey()) {
+            chip8.AdvanceClock(cyclesPerFrame);
+        } else {
+            chip8.Run(cyclesPerFrame);
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    return {job.frames * cyclesPerFrame, std::chrono::duration<double>(end - start).count(), chip8.FramebufferHash()};
+}
+
+static int Usage(char const *program, char const *problem) {
+    std::cerr << problem << "\nUsage: " << program << " <Manifest> <Results|-> [Threads] [CyclesPerFrame] [Dispatch]\n";
+    return EXIT_FAILURE;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        return Usage(argv[0], "Expected a manifest and a results file");
+    }
+
+    string results_filename = argv[2];
+    unsigned int threads = thread::hardware_concurrency();
+    unsigned int cyclesPerFrame = Chip8::DEFAULT_CYCLES_PER_FRAME;
+    DispatchMode mode = DispatchMode::Specialized;
+
+    uint64_t value;
+    // 0 threads means one per core
+    if (argc > 3) {
+        if (!ParseCount(argv[3], value) || value > 1024) {
+            return Usage(argv[0], "Threads must be between 0 and 1024");
+        }
+        if (value > 0) {
+            threads = value;
+        }
+    }
+    if (argc > 4) {
+        if (!ParseCount(argv[4], value) || value == 0 || value > Chip8::MAX_CYCLES_PER_FRAME) {
+            return Usage(argv[0], "CyclesPerFrame must be between 1 and 1000000");
+        }
+        cyclesPerFrame = value;
+    }
+    if (argc > 5 && !ParseDispatchMode(argv[5], mode)) {
+        std::cerr << "Unknown dispatch mode: " << argv[5] << "\n";
+        return EXIT_FAILURE;
+    }
+
+    vector<BatchJob> jobs;
+    if (!ReadManifest(argv[1], jobs)) {
+        return EXIT_FAILURE;
+    }
+
+    // Every ROM and script is read once, however many jobs share it. Jobs share the ROM's memory pages too, and only
+    // own the pages they write to.
+    map<string, PagedMemory> images;
+    map<string, vector<ScriptEvent>> scripts;
+    scripts["-"];
+    for (BatchJob &job: jobs) {
+        if (!images.count(job.rom)) {
+            vector<uint8_t> rom;
+            if (!ReadFile(job.rom, rom)) {
+                std::cerr << "Can't read ROM " << job.rom << "\n";
+                return EXIT_FAILURE;
+            }
+            images[job.rom] = Chip8::MakeImage(rom.data(), rom.size());
+        }
+        if (!scripts.count(job.script) && !ReadScript(job.script, scripts[job.script])) {
+            return EXIT_FAILURE;
+        }
+        job.image = &images[job.rom];
+        job.events = &scripts[job.script];
+    }
+
+    vector<BatchResult> results(jobs.size());
+    WorkStealingPool pool(threads);
+
+    auto start = std::chrono::steady_clock::now();
+    pool.Run(jobs.size(), [&](size_t i, unsigned int) {
+        results[i] = RunJob(jobs[i], cyclesPerFrame, mode);
+    });
+    auto end = std::chrono::steady_clock::now();
+
+    FILE *out = results_filename == "-" ? stdout : std::fopen(results_filename.c_str(), "w");
+    if (!out) {
+        std::cerr << "Can't write results to " << results_filename << "\n";
+        return EXIT_FAILURE;
+    }
+
+    uint64_t instructions = 0;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        std::fprintf(out, "%zu\t%s\t%llu\t%llu\t%llu\t%.6f\t%016llx\n", i, jobs[i].rom.c_str(),
+                     static_cast<unsigned long long>(jobs[i].seed), static_cast<unsigned long long>(jobs[i].frames),
+                     static_cast<unsigned long long>(results[i].instructions), results[i].seconds,
+                     static_cast<unsigned long long>(results[i].framebuffer));
+        instructions += results[i].instructions;
+    }
+    if (out != stdout) {
+        std::fclose(out);
+    }
+
+    // Compare runs with different thread counts to see how throughput scales
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double rate = seconds > 0 ? instructions / seconds / 1e6 : 0.0;
+    std::fprintf(stderr, "%zu jobs on %u threads (%llu steals) in %.3f s: %.1f jobs/s, %.2f M emulated instructions/s, "
+                         "%.2f M emulated instructions/s per thread\n",
+                 jobs.size(), pool.Threads(), static_cast<unsigned long long>(pool.steals.load()), seconds,
+                 seconds > 0 ? jobs.size() / seconds : 0.0, rate, rate / pool.Threads());
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,281 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "Benchmark.h"
+#include "Chip8.h"
+#include "BlockCache.h"
+#include "Jit.h"
+#include "Lockstep.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Instruction or fork count of a benchmark, at least 1. Prints the problem and usage otherwise.
+static bool ParseBenchCount(char const *text, char const *name, char const *usage, unsigned int &count) {
+    uint64_t value;
+    if (!ParseCount(text, value) || value == 0 || value > UINT32_MAX) {
+        std::cerr << name << " must be between 1 and 4294967295\n" << usage;
+        return false;
+    }
+    count = value;
+    return true;
+}
+
+// Every backend is seeded alike, so they all see the same random bytes
+int RunDispatchBenchmark(int argc, char *argv[], uint64_t seed) {
+    char const *usage = "Usage: --bench <Cycles> <ROM>...\n";
+    unsigned int cycles;
+    if (argc < 2) {
+        std::cerr << usage;
+        return EXIT_FAILURE;
+    }
+    if (!ParseBenchCount(argv[0], "Cycles", usage, cycles)) {
+        return EXIT_FAILURE;
+    }
+    bool mismatch = false;
+
+    for (int r = 1; r < argc; ++r) {
+        char const *rom_filename = argv[r];
+        std::cout << rom_filename << "\n";
+
+        uint64_t referenceHash = 0;
+
+        // Every backend, then the default one again with wait loops skipped
+        vector<DispatchMode> modes = DispatchModes();
+        modes.push_back(DispatchMode::Specialized);
+
+        for (size_t m = 0; m < modes.size(); ++m) {
+            DispatchMode mode = modes[m];
+            bool skipIdle = m == modes.size() - 1;
+            Chip8 chip8;
+            chip8.Seed(seed);
+            chip8.LoadROM(rom_filename);
+            chip8.dispatch_mode = mode;
+            chip8.skip_idle_loops = skipIdle;
+            if (mode == DispatchMode::Blocks) {
+                chip8.block_cache = make_unique<BlockCache>();
+                chip8.block_cache->count_hits = true;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            chip8.Run(cycles);
+            auto end = std::chrono::steady_clock::now();
+
+            double seconds = std::chrono::duration<double>(end - start).count();
+            uint64_t hash = chip8.StateHash();
+            if (mode == DispatchMode::Switch) {
+                referenceHash = hash;
+            }
+            bool matches = hash == referenceHash;
+            mismatch |= !matches;
+
+            string name = string(DispatchModeName(mode)) + (skipIdle ? "+idle" : "");
+            std::printf("  %-17s %10.2f M instructions/s  state %016llx %s\n", name.c_str(),
+                        cycles / seconds / 1e6, static_cast<unsigned long long>(hash),
+                        matches ? "ok" : "MISMATCH");
+
+            if (chip8.block_cache) {
+                std::printf("  %-17s block hits %llu, misses %llu, invalidations %llu\n", "",
+                            static_cast<unsigned long long>(chip8.block_cache->hits),
+                            static_cast<unsigned long long>(chip8.block_cache->misses),
+                            static_cast<unsigned long long>(chip8.block_cache->invalidations));
+            }
+            if (chip8.jit) {
+                std::printf("  %-17s jit compiled %llu, invalidations %llu, flushes %llu\n", "",
+                            static_cast<unsigned long long>(chip8.jit->compiled),
+                            static_cast<unsigned long long>(chip8.jit->invalidations),
+                            static_cast<unsigned long long>(chip8.jit->flushes));
+            }
+        }
+    }
+
+    return mismatch ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// Keys lane holds during frame: a new one every half second, sometimes none
+static uint16_t LaneKeys(unsigned int lane, uint64_t frame, bool sameInput) {
+    uint64_t h = (frame / 30) * 31 + (sameInput ? 0 : lane * 7);
+    return h % 5 == 0 ? 0 : 1u << (h % 16);
+}
+
+int RunLockstepBenchmark(int argc, char *argv[], uint64_t seed) {
+    char const *usage = "Usage: --bench-lockstep <Cycles> <ROM>...\n";
+    unsigned int cycles;
+    if (argc < 2) {
+        std::cerr << usage;
+        return EXIT_FAILURE;
+    }
+    if (!ParseBenchCount(argv[0], "Cycles", usage, cycles)) {
+        return EXIT_FAILURE;
+    }
+    unsigned int lanes = LockstepGroup::LANES;
+    bool mismatch = false;
+
+    for (int r = 1; r < argc; ++r) {
+        char const *rom_filename = argv[r];
+        std::cout << rom_filename << "\n";
+
+        for (bool sameInput: {true, false}) {
+            Chip8 prototype;
+            prototype.LoadROM(rom_filename);
+            unsigned int cyclesPerFrame = prototype.DEFAULT_CYCLES_PER_FRAME;
+            uint64_t frames = cycles / cyclesPerFrame;
+
+            // Every lane on its own, through Chip8::Cycle() (switch) and through the fastest table
+            vector<uint64_t> reference(lanes);
+            double scalarSeconds[2]{};
+            for (DispatchMode mode: {DispatchMode::Switch, DispatchMode::Specialized}) {
+                for (unsigned int lane = 0; lane < lanes; ++lane) {
+                    Chip8 chip8;
+                    chip8.LoadROM(rom_filename);
+                    chip8.Seed(seed, sameInput ? Pcg32::DEFAULT_STREAM : lane);
+                    chip8.dispatch_mode = mode;
+
+                    auto start = std::chrono::steady_clock::now();
+                    for (uint64_t frame = 0; frame < frames; ++frame) {
+                        chip8.keypad.store(LaneKeys(lane, frame, sameInput), memory_order_relaxed);
+                        chip8.Run(cyclesPerFrame);
+                    }
+                    auto end = std::chrono::steady_clock::now();
+                    scalarSeconds[mode == DispatchMode::Specialized] += std::chrono::duration<double>(end - start).count();
+
+                    if (mode == DispatchMode::Switch) {
+                        reference[lane] = chip8.StateHash();
+                    }
+                }
+            }
+
+            auto group = make_unique<LockstepGroup>(prototype, lanes);
+            for (unsigned int lane = 0; lane < lanes; ++lane) {
+                group->Seed(lane, seed, sameInput ? Pcg32::DEFAULT_STREAM : lane);
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            for (uint64_t frame = 0; frame < frames; ++frame) {
+                for (unsigned int lane = 0; lane < lanes; ++lane) {
+                    group->SetKeypad(lane, LaneKeys(lane, frame, sameInput));
+                }
+                group->Run(cyclesPerFrame);
+            }
+            auto end = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(end - start).count();
+
+            unsigned int matching = 0;
+            for (unsigned int lane = 0; lane < lanes; ++lane) {
+                Chip8 chip8;
+                group->ExportLane(lane, chip8);
+                matching += chip8.StateHash() == reference[lane];
+            }
+            mismatch |= matching != lanes;
+
+            double instructions = static_cast<double>(frames) * cyclesPerFrame * lanes;
+            std::printf("  %s, %u lanes\n", sameInput ? "same input" : "different input per lane", lanes);
+            std::printf("    %-12s %10.2f M instructions/s\n", "switch", instructions / scalarSeconds[0] / 1e6);
+            std::printf("    %-12s %10.2f M instructions/s\n", "specialized", instructions / scalarSeconds[1] / 1e6);
+            std::printf("    %-12s %10.2f M instructions/s  %.1f lanes per step, %llu split off, %u/%u lanes %s\n",
+                        "lockstep", instructions / seconds / 1e6,
+                        group->group_steps ? static_cast<double>(group->lane_steps) / group->group_steps : 0.0,
+                        static_cast<unsigned long long>(group->splits), matching, lanes,
+                        matching == lanes ? "ok" : "MISMATCH");
+        }
+    }
+
+    return mismatch ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// Frames the parent runs before it is forked, and children checked against a replay from scratch
+static const uint64_t FORK_WARMUP_FRAMES = 600;
+static const unsigned int FORK_CHECKS = 16;
+
+// Child i's state after steps instructions, rebuilt without forking
+static uint64_t ReplayChild(char const *rom_filename, uint64_t seed, unsigned int i, unsigned int steps) {
+    Chip8 chip8;
+    chip8.LoadROM(rom_filename);
+    chip8.Seed(seed);
+    for (uint64_t frame = 0; frame < FORK_WARMUP_FRAMES; ++frame) {
+        chip8.keypad.store(LaneKeys(0, frame, true), memory_order_relaxed);
+        chip8.Run(chip8.DEFAULT_CYCLES_PER_FRAME);
+    }
+    chip8.keypad.store(LaneKeys(i, FORK_WARMUP_FRAMES, false), memory_order_relaxed);
+    chip8.Run(steps);
+    return chip8.StateHash();
+}
+
+int RunForkBenchmark(int argc, char *argv[], uint64_t seed) {
+    char const *usage = "Usage: --bench-fork <Forks> <ROM>...\n";
+    unsigned int forks;
+    if (argc < 2) {
+        std::cerr << usage;
+        return EXIT_FAILURE;
+    }
+    if (!ParseBenchCount(argv[0], "Forks", usage, forks)) {
+        return EXIT_FAILURE;
+    }
+    bool mismatch = false;
+
+    for (int r = 1; r < argc; ++r) {
+        char const *rom_filename = argv[r];
+        std::cout << rom_filename << "\n";
+
+        Chip8 parent;
+        parent.LoadROM(rom_filename);
+        parent.Seed(seed);
+        parent.dispatch_mode = DispatchMode::Specialized;
+        for (uint64_t frame = 0; frame < FORK_WARMUP_FRAMES; ++frame) {
+            parent.keypad.store(LaneKeys(0, frame, true), memory_order_relaxed);
+            parent.Run(parent.DEFAULT_CYCLES_PER_FRAME);
+        }
+        uint64_t parentHash = parent.StateHash();
+
+        // No steps, one instruction, one frame and one second of emulated time per child
+        for (unsigned int steps: {0u, 1u, Chip8::DEFAULT_CYCLES_PER_FRAME, Chip8::DEFAULT_CYCLES_PER_FRAME * 60}) {
+            for (bool reuse: {false, true}) {
+                vector<uint64_t> hashes(FORK_CHECKS);
+                uint64_t pagesCopied = 0;
+                Chip8 reused;
+                reused.dispatch_mode = parent.dispatch_mode;
+
+                auto start = std::chrono::steady_clock::now();
+                for (unsigned int i = 0; i < forks; ++i) {
+                    unique_ptr<Chip8> forked;
+                    Chip8 *child = &reused;
+                    if (reuse) {
+                        reused.ForkFrom(parent);
+                    } else {
+                        forked = parent.Fork();
+                        child = forked.get();
+                    }
+                    child->keypad.store(LaneKeys(i, FORK_WARMUP_FRAMES, false), memory_order_relaxed);
+                    child->Run(steps);
+                    pagesCopied += PagedMemory::PAGE_COUNT - child->memory.SharedPages(parent.memory);
+                    if (i < FORK_CHECKS) {
+                        hashes[i] = child->StateHash();
+                    }
+                }
+                auto end = std::chrono::steady_clock::now();
+                double seconds = std::chrono::duration<double>(end - start).count();
+
+                unsigned int checks = std::min(forks, FORK_CHECKS);
+                unsigned int matching = 0;
+                for (unsigned int i = 0; i < checks; ++i) {
+                    matching += hashes[i] == ReplayChild(rom_filename, seed, i, steps);
+                }
+                bool ok = matching == checks && parent.StateHash() == parentHash;
+                mismatch |= !ok;
+
+                string name = string(reuse ? "ForkFrom" : "Fork") + " + " + to_string(steps);
+                std::printf("  %-14s %10.0f forks/s  %8.1f ns each, %.2f pages copied, %u/%u children %s\n",
+                            name.c_str(), forks / seconds, seconds / forks * 1e9,
+                            static_cast<double>(pagesCopied) / forks, matching, checks, ok ? "ok" : "MISMATCH");
+            }
+        }
+    }
+
+    return mismatch ? EXIT_FAILURE : EXIT_SUCCESS;
+}
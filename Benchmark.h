@@ -0,0 +1,25 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_BENCHMARK_H
+#define CHIP8_INTERPRETER_BENCHMARK_H
+
+#include <cstdint>
+
+// Run every ROM with each dispatch backend, check they end in the same state and report instructions per second.
+// Arguments: <Cycles> <ROM>...
+int RunDispatchBenchmark(int argc, char *argv[], uint64_t seed);
+
+// Run 32 copies of each ROM with their own inputs one by one and as a LockstepGroup, check every lane ends in the same
+// state and report aggregate instructions per second.
+// Arguments: <Cycles> <ROM>...
+int RunLockstepBenchmark(int argc, char *argv[], uint64_t seed);
+
+// Fork a running instance of each ROM over and over, step every child with its own input and discard it, as a tree
+// search would. Check children against replays from scratch and that the parent is left alone, and report forks per
+// second.
+// Arguments: <Forks> <ROM>...
+int RunForkBenchmark(int argc, char *argv[], uint64_t seed);
+
+#endif //CHIP8_INTERPRETER_BENCHMARK_H
@@ -0,0 +1,237 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "BlockCache.h"
+
+static bool IsSkip(uint16_t opcode) {
+    switch (opcode >> 12u) {
+        case 0x3:
+        case 0x4:
+        case 0x5:
+        case 0x9:
+        case 0xE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Timers read cycle_count, clears, draws and key reads only for latency tracing
+static uint8_t ReadsCycles(uint16_t opcode) {
+    switch (opcode >> 12u) {
+        case 0x0:
+            return opcode == 0x00E0 ? BlockCache::CYCLES_TRACED : 0;
+        case 0xD:
+        case 0xE:
+            return BlockCache::CYCLES_TRACED;
+        case 0xF:
+            switch (opcode & 0x00FFu) {
+                case 0x0A:
+                    return BlockCache::CYCLES_TRACED;
+                case 0x07:
+                case 0x15:
+                case 0x18:
+                    return BlockCache::CYCLES_ALWAYS;
+                default:
+                    return 0;
+            }
+        default:
+            return 0;
+    }
+}
+
+bool BlockCache::EndsBlock(uint16_t opcode) {
+    switch (opcode >> 12u) {
+        case 0x0:
+            return (opcode & 0x000Fu) == 0xE;
+        case 0x1:
+        case 0x2:
+        case 0x3:
+        case 0x4:
+        case 0x5:
+        case 0x9:
+        case 0xB:
+        case 0xE:
+            return true;
+        case 0xF:
+            switch (opcode & 0x00FFu) {
+                case 0x0A:
+                case 0x33:
+                case 0x55:
+                    return true;
+                default:
+                    return false;
+            }
+        default:
+            return false;
+    }
+}
+
+Block *BlockCache::Translate(Chip8 &c, uint16_t start) {
+    auto block = make_unique<Block>();
+    block->start = start;
+    block->count = 0;
+    block->reads_cycles = 0;
+    block->jump_tail = false;
+    block->link_generation[0] = 0;
+    block->link_generation[1] = 0;
+
+    uint16_t address = start;
+    while (block->count < MAX_BLOCK_INSTRUCTIONS) {
+        uint16_t opcode = c.memory.ReadOpcode(address);
+        block->instructions[block->count++] = Decode(opcode);
+        block->reads_cycles |= ReadsCycles(opcode);
+        address += 2;
+
+        // Blocks never wrap around the end of memory
+        if (EndsBlock(opcode) || address >= PagedMemory::SIZE) {
+            break;
+        }
+    }
+
+    // Where the block continues, linked by RunBlocks()
+    uint16_t last = block->instructions[block->count - 1].opcode;
+    block->successors = 1;
+    block->successor_pc[0] = address & 0x0FFFu;
+    if ((last >> 12u) == 0x1 || (last >> 12u) == 0x2) {
+        block->successor_pc[0] = last & 0x0FFFu;
+    } else if (IsSkip(last) && address < PagedMemory::SIZE && (c.memory.ReadOpcode(address) >> 12u) == 0x1) {
+        // Jumps, or skips the jump
+        block->jump_tail = true;
+        block->jump_pc = address;
+        block->jump_target = c.memory.ReadOpcode(address) & 0x0FFFu;
+        address += 2;
+        block->successors = 2;
+        block->successor_pc[0] = block->jump_target;
+        block->successor_pc[1] = address & 0x0FFFu;
+    } else if (IsSkip(last) || (last & 0xF0FFu) == 0xF00Au) {
+        // Falls through, or skips one instruction / waits on the key again
+        block->successors = 2;
+        block->successor_pc[1] = (IsSkip(last) ? address + 2 : address - 2) & 0x0FFFu;
+    } else if (EndsBlock(last) && (last >> 12u) != 0xF) {
+        // Returns and Bnnn; memory writes continue after themselves like any other instruction
+        block->successors = 0;
+    }
+    block->size = address - start;
+
+    for (uint16_t i = 0; i < block->size; ++i) {
+        ++coverage[(start + i) & 0x0FFFu];
+    }
+
+    blocks[start].swap(block);
+    ++misses;
+    return blocks[start].get();
+}
+
+Block *BlockCache::Lookup(Chip8 &c) {
+    Block *block = blocks[c.pc & 0x0FFFu].get();
+    return block ? block : Translate(c, c.pc & 0x0FFFu);
+}
+
+template<bool CountHits>
+void BlockCache::RunBlocks(Chip8 &c, unsigned int cycles) {
+    // Blocks with an instruction that reads cycle_count have to keep it exact
+    uint8_t exact = CYCLES_ALWAYS | (c.trace_latency ? CYCLES_TRACED : 0);
+    // Counted locally, every block that isn't a miss is a hit
+    uint64_t runs = 0;
+    uint64_t previous_misses = misses;
+    Block *block = Lookup(c);
+
+    for (;;) {
+        if (CountHits) {
+            ++runs;
+        }
+
+        // The last block of a slice may only run partially, then nothing follows it
+        unsigned int count = block->count < cycles ? block->count : cycles;
+        cycles -= count;
+
+        // Only the last instruction of a block reads or sets pc, so it can be advanced up front
+        DecodedInstruction const *instruction = block->instructions;
+        if (block->reads_cycles & exact) {
+            do {
+                c.pc += 2;
+                instruction->handler(c, *instruction);
+                ++c.cycle_count;
+                ++instruction;
+            } while (--count);
+        } else {
+            c.pc += count * 2;
+            c.cycle_count += count;
+            do {
+                instruction->handler(c, *instruction);
+                ++instruction;
+            } while (--count);
+        }
+
+        if (cycles == 0) {
+            break;
+        }
+
+        // Follow the link to the block that comes next, look it up and link it otherwise. Returns and Bnnn link to
+        // the address they went to last time, a skip over a jump runs the jump first unless it skipped it.
+        unsigned int successor = 0;
+        if (block->successors == 2) {
+            if (block->jump_tail && (c.pc & 0x0FFFu) == block->jump_pc) {
+                c.pc = block->jump_target;
+                ++c.cycle_count;
+                if (--cycles == 0) {
+                    break;
+                }
+            }
+            successor = (c.pc & 0x0FFFu) != block->successor_pc[0];
+        } else if (block->successors == 0 && (c.pc & 0x0FFFu) != block->successor_pc[0]) {
+            block->successor_pc[0] = c.pc & 0x0FFFu;
+            block->link_generation[0] = 0;
+        }
+        if (block->link_generation[successor] == generation) {
+            block = block->next[successor];
+        } else {
+            Block *previous = block;
+            block = Lookup(c);
+            previous->next[successor] = block;
+            previous->link_generation[successor] = generation;
+            // Blocks dropped since the last lookup have finished running; every drop breaks the links and gets here
+            retired.clear();
+        }
+    }
+
+    if (CountHits) {
+        hits += runs - (misses - previous_misses);
+    }
+}
+
+void BlockCache::Run(Chip8 &c, unsigned int cycles) {
+    if (count_hits) {
+        RunBlocks<true>(c, cycles);
+    } else {
+        RunBlocks<false>(c, cycles);
+    }
+    retired.clear();
+}
+
+void BlockCache::Invalidate(uint16_t address, uint16_t length) {
+    for (uint16_t i = 0; i < length; ++i) {
+        uint16_t written = (address + i) & 0x0FFFu;
+        if (!coverage[written]) {
+            continue;
+        }
+
+        // Any block overlapping the written byte starts at most one maximal block before it
+        for (unsigned int back = 0; back < MAX_BLOCK_INSTRUCTIONS * 2 && coverage[written]; ++back) {
+            uint16_t start = (written - back) & 0x0FFFu;
+            Block *block = blocks[start].get();
+
+            if (block && back < block->size) {
+                for (uint16_t j = 0; j < block->size; ++j) {
+                    --coverage[(start + j) & 0x0FFFu];
+                }
+                // The block may be the one executing the write, so keep it alive until Run() returns
+                retired.push_back(move(blocks[start]));
+                ++generation;
+                ++invalidations;
+            }
+        }
+    }
+}
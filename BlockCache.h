@@ -0,0 +1,71 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_BLOCKCACHE_H
+#define CHIP8_INTERPRETER_BLOCKCACHE_H
+
+#include "Chip8.h"
+#include "DecodeCache.h"
+
+// A straight-line run of guest instructions, ending at the first jump, call, return, skip, key wait or memory write.
+// A skip over a jump takes the jump along as a conditional branch. The instructions are stored inline, so running a
+// block touches no other allocation.
+struct Block {
+    static const unsigned int MAX_INSTRUCTIONS = 64;
+
+    uint16_t start;
+    uint16_t size; // in bytes
+    uint16_t count;
+    // BlockCache::CYCLES_* of the instructions that read cycle_count. Other blocks bring pc and cycle_count up to
+    // date once, before their first instruction.
+    uint8_t reads_cycles;
+    // Whether the block ends with a skip over a 1nnn at jump_pc, which jumps to jump_target unless skipped
+    bool jump_tail;
+    uint16_t jump_pc;
+    uint16_t jump_target;
+    // Number of addresses the block can continue at, 0 when only a lookup can tell (after a return or Bnnn)
+    uint8_t successors;
+    uint16_t successor_pc[2];
+    // The blocks found at the successors last time, valid while link_generation matches the cache's generation
+    Block *next[2];
+    uint64_t link_generation[2];
+    DecodedInstruction instructions[MAX_INSTRUCTIONS];
+};
+
+// Translates each basic block once and runs the whole block per dispatch.
+// Blocks are cached by start address and dropped when guest code writes into their address range.
+class BlockCache {
+public:
+    static const unsigned int MAX_BLOCK_INSTRUCTIONS = Block::MAX_INSTRUCTIONS;
+    static const uint8_t CYCLES_ALWAYS = 1;
+    static const uint8_t CYCLES_TRACED = 2;
+
+    void Run(Chip8 &c, unsigned int cycles);
+
+    void Invalidate(uint16_t address, uint16_t length);
+
+    // Whether an instruction has to be the last one of its block
+    static bool EndsBlock(uint16_t opcode);
+
+    // Blocks run from the cache, only counted when count_hits is set
+    uint64_t hits{};
+    bool count_hits = false;
+    uint64_t misses{};
+    uint64_t invalidations{};
+
+private:
+    template<bool CountHits>
+    void RunBlocks(Chip8 &c, unsigned int cycles);
+    Block *Lookup(Chip8 &c);
+    Block *Translate(Chip8 &c, uint16_t start);
+
+    unique_ptr<Block> blocks[4096];
+    // Bumped whenever a block is dropped, which breaks every link to it
+    uint64_t generation = 1;
+    // Number of cached blocks covering each address, so writes to plain data skip the block search
+    uint8_t coverage[4096]{};
+    vector<unique_ptr<Block>> retired;
+};
+
+#endif //CHIP8_INTERPRETER_BLOCKCACHE_H
@@ -4,10 +4,14 @@
 
 #include <iostream>
 #include "Chip8.h"
+#include "Instructions.h"
+#include "DecodeCache.h"
+#include "BlockCache.h"
+#include "Jit.h"
+#include "AotRuntime.h"
+#include "DisplayExpand.h"
 #include "fstream"
-#include "Platform.h"
 #include <chrono>
-#include <random>
 #include <cstdio>
 #include <cstring>
 #include <string>
@@ -16,454 +20,267 @@
 
 using namespace std;
 
-Chip8::Chip8() {
+// Memory with only the font loaded, shared by every new instance until it loads a ROM
+static PagedMemory const &FontImage() {
+    static PagedMemory const image = Chip8::MakeImage(nullptr, 0);
+    return image;
+}
+
+Chip8::Chip8() : memory(FontImage()) {
     pc = START_ADDRESS;
-    LoadFontset();
+    cycles_per_second = DEFAULT_CYCLES_PER_FRAME * FRAME_RATE;
 
-    //Init RNG
-    unsigned seed = chrono::steady_clock::now().time_since_epoch().count();
-    randGen.seed(seed);
-    randByte = uniform_int_distribution<int>(0, 255);
+    //Init RNG, unseeded runs differ every time
+    Seed(chrono::steady_clock::now().time_since_epoch().count());
 
 }
 
-void Chip8::LoadROM(char const *filename) {
+Chip8::~Chip8() = default;
+
+bool Chip8::LoadROM(char const *filename) {
     ifstream rom_file;
     rom_file.open(filename, ios::binary | ios::ate);
 
-    if (rom_file.is_open()) {
-        streampos size = rom_file.tellg();
-        char *buffer = new char[size];
-
-        rom_file.seekg(0, ios::beg);
-        rom_file.read(buffer, size);
-        rom_file.close();
-
-        for (long i = 0; i < size; i++) {
-            memory[START_ADDRESS + i] = buffer[i];
-        }
+    if (!rom_file.is_open()) {
+        return false;
+    }
 
-        delete[] buffer;
-        //spdlog::info("Rom Loaded.");
+    streamoff size = rom_file.tellg();
+    if (size < 0) {
+        return false;
     }
+    // Anything past the end of memory wouldn't be loaded anyway (and a directory reports a bogus size)
+    vector<char> buffer(std::min<streamoff>(size, PagedMemory::SIZE - START_ADDRESS));
 
+    rom_file.seekg(0, ios::beg);
+    if (!rom_file.read(buffer.data(), buffer.size())) {
+        return false;
+    }
+    rom_file.close();
+
+    LoadROM(reinterpret_cast<uint8_t const *>(buffer.data()), buffer.size());
+    //spdlog::info("Rom Loaded.");
+    return true;
+}
+
+// Starts from a fresh image of its own; instances running the same ROM can share one with LoadImage() instead
+void Chip8::LoadROM(uint8_t const *data, size_t size) {
+    LoadImage(MakeImage(data, size));
+}
+
+PagedMemory Chip8::MakeImage(uint8_t const *data, size_t size) {
+    auto image = make_shared<MemoryImage>();
+    std::copy(FONTSET, FONTSET + FONTSET_SIZE, image->bytes + FONTSET_START_ADDRESS);
+    std::copy(data, data + std::min<size_t>(size, PagedMemory::SIZE - START_ADDRESS), image->bytes + START_ADDRESS);
+    return PagedMemory(image);
+}
+
+void Chip8::LoadImage(PagedMemory const &image) {
+    memory = image;
+    MemoryReplaced();
+}
+
+unique_ptr<Chip8> Chip8::Fork() const {
+    auto child = make_unique<Chip8>();
+    child->dispatch_mode = dispatch_mode;
+    child->skip_idle_loops = skip_idle_loops;
+    child->ForkFrom(*this);
+    return child;
+}
+
+// Translation caches aren't shared: the child builds its own, and an instance forked into drops what it had
+void Chip8::ForkFrom(Chip8 const &parent) {
+    std::memcpy(registers, parent.registers, sizeof(registers));
+    pc = parent.pc;
+    index = parent.index;
+    opcode = parent.opcode;
+    sp = parent.sp;
+    cycle_count = parent.cycle_count;
+    std::memcpy(stack, parent.stack, sizeof(stack));
+    delay_timer = parent.delay_timer;
+    sound_timer = parent.sound_timer;
+    keypad.store(parent.keypad.load(memory_order_relaxed), memory_order_relaxed);
+    dirty_rows = 0xFFFFFFFF;
+    delay_timer_tick = parent.delay_timer_tick;
+    sound_timer_tick = parent.sound_timer_tick;
+    clock_base_cycle = parent.clock_base_cycle;
+    clock_base_tick = parent.clock_base_tick;
+    cycles_per_second = parent.cycles_per_second;
+    std::memcpy(display, parent.display, sizeof(display));
+    memory = parent.memory;
+    std::memcpy(key_read_cycle, parent.key_read_cycle, sizeof(key_read_cycle));
+    draw_cycle = parent.draw_cycle;
+    trace_latency = parent.trace_latency;
+    rng = parent.rng;
+    MemoryReplaced();
 }
 
 void Chip8::LoadFontset() {
-    for (unsigned int i = 0; i < FONTSET_SIZE; ++i) {
-        memory[FONTSET_START_ADDRESS + i] = fontset[i];
-    }
+    memory.Store(FONTSET_START_ADDRESS, FONTSET, FONTSET_SIZE);
+    MemoryWritten(FONTSET_START_ADDRESS, FONTSET_SIZE);
     //spdlog::info("FontSet loaded.");
 }
 
-uint8_t Chip8::getRandomByte() {
-    return randByte(randGen);
-}
-
-// Instruction Set
-
-// CLS
-// CLear the display
-void Chip8::OP_00E0() {
-    std::memset(display, 0, sizeof(display));
-}
-
-// RET
-// Return from the subroutine
-void Chip8::OP_00EE() {
-    --sp;
-    pc = stack[sp];
-}
-
-// JP addr
-// Jump to location nnn
-void Chip8::OP_1nnn() {
-    uint16_t address = opcode & 0x0FFFu;
-
-    pc = address;
-}
-
-// CALL addr
-// Call subroutine at nnn
-void Chip8::OP_2nnn() {
-    uint16_t address = opcode & 0x0FFFu;
-
-    stack[sp] = pc;
-    ++sp;
-    pc = address;
-}
-
-// SE Vx, byte
-// Skip next instruction if Vx = kk
-void Chip8::OP_3xkk() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-    uint8_t value = opcode & 0x00FFu;
-
-    if (registers[Vx] == value) {
-        pc += 2;
+bool ParseCount(string const &text, uint64_t &count) {
+    if (text.empty() || text.size() > 19 || text.find_first_not_of("0123456789") != string::npos) {
+        return false;
     }
+    count = stoull(text);
+    return true;
 }
 
-// SNE Vx, byte
-// Skip next instruction if Vx != kk
-void Chip8::OP_4xkk() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-    uint8_t value = opcode & 0x00FFu;
-
-    if (registers[Vx] != value) {
-        pc += 2;
+bool ParseSeed(string const &text, uint64_t &seed) {
+    if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+        if (text.size() > 18 || text.find_first_not_of("0123456789abcdefABCDEF", 2) != string::npos) {
+            return false;
+        }
+        seed = stoull(text.substr(2), nullptr, 16);
+        return true;
     }
-}
-
-// SE Vx, Vy
-// Skip next instruction if Vx = Vy
-void Chip8::OP_5xy0() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-    uint8_t Vy = (opcode & 0x00F0u) >> 4u;
-
-    if (registers[Vx] == registers[Vy]) {
-        pc += 2;
+    // Up to 20 digits, the last one may still overflow
+    if (text.empty() || text.size() > 20 || text.find_first_not_of("0123456789") != string::npos ||
+        (text.size() == 20 && text > "18446744073709551615")) {
+        return false;
     }
+    seed = stoull(text);
+    return true;
 }
 
-// LD Vx, byte
-// Set Vx = kk
-void Chip8::OP_6xkk() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-    uint8_t value = opcode & 0x00FFu;
-
-    registers[Vx] = value;
-}
-
-
-// ADD Vx, byte
-// Set Vx = Vx + kk
-void Chip8::OP_7xkk() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-    uint8_t value = opcode & 0x00FFu;
-
-    registers[Vx] += value;
-}
-
-
-// LD Vx, Vy
-// Set Vx = Vy
-void Chip8::OP_8xy0() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-    uint8_t Vy = (opcode & 0x00F0u) >> 4u;
-
-    registers[Vx] = registers[Vy];
-}
-
-
-// OR Vx, Vy
-// Set Vx = Vx OR Vy
-void Chip8::OP_8xy1() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-    uint8_t Vy = (opcode & 0x00F0u) >> 4u;
-
-    registers[Vx] |= registers[Vy];
-}
-
-
-// AND Vx, Vy
-// Set Vx = Vx AND Vy
-void Chip8::OP_8xy2() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-    uint8_t Vy = (opcode & 0x00F0u) >> 4u;
-
-    registers[Vx] &= registers[Vy];
-}
-
-
-// XOR Vx, Vy
-// Set Vx = Vx XOR Vy
-void Chip8::OP_8xy3() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-    uint8_t Vy = (opcode & 0x00F0u) >> 4u;
-
-    registers[Vx] ^= registers[Vy];
-}
-
-
-// ADD Vx, Vy
-// Set Vx = Vx + Vy, set VF = carry
-void Chip8::OP_8xy4() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-    uint8_t Vy = (opcode & 0x00F0u) >> 4u;
-
-    uint16_t sum = registers[Vx] + registers[Vy];
-
-    if (sum > 255u) {
-        registers[0xF] = 1;
-    } else {
-        registers[0xF] = 0;
+void Chip8::MemoryWritten(uint16_t address, uint16_t length) {
+    if (decode_cache) {
+        decode_cache->Invalidate(address, length);
     }
-
-    registers[Vx] = sum & 0xFFu;
-}
-
-
-// SUB Vx, Vy
-// Set Vx = Vx - Vy, set VF = NOT borrow
-void Chip8::OP_8xy5() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-    uint8_t Vy = (opcode & 0x00F0u) >> 4u;
-
-    uint16_t sub = registers[Vx] - registers[Vy];
-
-    if (sub > 0) {
-        registers[0xF] = 1;
-    } else {
-        registers[0xF] = 0;
+    if (block_cache) {
+        block_cache->Invalidate(address, length);
     }
-
-    registers[Vx] = sub & 0xFFu;
-}
-
-
-// SHR Vx
-// Set Vx = Vx SHR 1
-void Chip8::OP_8xy6() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-
-    registers[0xF] = (registers[Vx] & 0x1u);
-    registers[Vx] >>= 1;
-}
-
-
-// SUBN Vx, Vy
-// Set Vx = Vy - Vx, set VF = NOT borrow
-void Chip8::OP_8xy7() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-    uint8_t Vy = (opcode & 0x00F0u) >> 4u;
-
-    uint16_t sub = registers[Vx] - registers[Vy];
-
-    if (sub <= 0) {
-        registers[0xF] = 1;
-    } else {
-        registers[0xF] = 0;
+    if (jit) {
+        jit->Invalidate(address, length);
     }
-
-    registers[Vx] = sub & 0xFFu;
-}
-
-
-// SHL Vx {, Vy}
-// Set Vx = Vx SHL 1
-void Chip8::OP_8xyE() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-
-    registers[0xF] = (registers[Vx] & 0x80u) >> 7u;
-    registers[Vx] <<= 1;
-}
-
-
-// SNE Vx, Vy
-// Skip next instruction if Vx != Vy
-void Chip8::OP_9xy0() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-    uint8_t Vy = (opcode & 0x00F0u) >> 4u;
-
-    if (registers[Vx] != registers[Vy]) {
-        pc += 2;
+    if (aot) {
+        aot->Invalidate(address, length);
     }
 }
 
-
-// LD I, addr
-// Set I = nnn
-void Chip8::OP_Annn() {
-    index = opcode & 0x0FFFu;
+void Chip8::MemoryReplaced() {
+    if (decode_cache) {
+        decode_cache->Invalidate(0, PagedMemory::SIZE);
+    }
+    if (block_cache) {
+        block_cache->Invalidate(0, PagedMemory::SIZE);
+    }
+    if (jit) {
+        jit->Invalidate(0, PagedMemory::SIZE);
+    }
+    if (aot) {
+        aot->Reset(*this);
+    }
 }
 
-
-// JP V0, addr
-// Jump to location nnn + V0
-void Chip8::OP_Bnnn() {
-    uint16_t address = (opcode & 0x0FFFu) + registers[0];
-
-    pc = address;
+void Chip8::Seed(uint64_t seed, uint64_t stream) {
+    rng.Seed(seed, stream);
 }
 
+// Timers
 
-// RND Vx, byte
-// Set Vx = random byte AND kk
-void Chip8::OP_Cxkk() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-    uint8_t value = opcode & 0x00FFu;
-
-    registers[Vx] = value & getRandomByte();
+// Change the emulated instruction rate without disturbing timers that are already running
+// A rate of 0 is taken as 1: the timer arithmetic divides by it
+void Chip8::SetClockRate(unsigned int cyclesPerSecond) {
+    clock_base_tick = CurrentTick();
+    clock_base_cycle = cycle_count;
+    cycles_per_second = std::max(cyclesPerSecond, 1u);
 }
 
-
-// DRW Vx, Vy, nibble
-// Display n-byte sprite starting at memory location I at (Vx, Vy), set VF = collision
-void Chip8::OP_Dxyn() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-    uint8_t Vy = (opcode & 0x00F0u) >> 4u;
-    uint8_t value = opcode & 0x000Fu;
-
-    // Wrap if going beyond screen boundaries
-    uint8_t xPos = registers[Vx] % VIDEO_WIDTH;
-    uint8_t yPos = registers[Vy] % VIDEO_HEIGHT;
-
-    registers[0xF] = 0;
-
-    for (unsigned int row = 0; row < value; ++row) {
-        uint8_t spriteByte = memory[index + row];
-
-        for (unsigned int col = 0; col < 8; ++col) {
-            uint8_t spritePixel = spriteByte & (0x80u >> col);
-            uint32_t *screenPixel = &display[(yPos + row) * VIDEO_WIDTH + (xPos + col)];
-
-            // Sprite pixel is on
-            if (spritePixel) {
-                // Screen pixel also on - collision
-                if (*screenPixel == 0xFFFFFFFF) {
-                    registers[0xF] = 1;
-                }
-
-                // Effectively XOR with the sprite pixel
-                *screenPixel ^= 0xFFFFFFFF;
-            }
-        }
-    }
-
-
+// Number of 60 Hz timer ticks elapsed on the virtual clock
+uint64_t Chip8::CurrentTick() const {
+    return TickAt(cycle_count);
 }
 
-
-// SKP Vx
-// Skip next instruction if key with the value of Vx is pressed
-void Chip8::OP_Ex9E() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-
-    if (keypad[registers[Vx]]) {
-        pc += 2;
-    }
-
+uint64_t Chip8::TickAt(uint64_t cycle) const {
+    return clock_base_tick + (cycle - clock_base_cycle) * TIMER_RATE / cycles_per_second;
 }
 
-
-// SKNP Vx
-// Skip next instruction if key with the value of Vx is not pressed
-void Chip8::OP_ExA1() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-
-    if (!keypad[registers[Vx]]) {
-        pc += 2;
+uint64_t Chip8::CycleAtTick(uint64_t tick) const {
+    if (tick <= clock_base_tick) {
+        return clock_base_cycle;
     }
+    return clock_base_cycle + ((tick - clock_base_tick) * cycles_per_second + TIMER_RATE - 1) / TIMER_RATE;
 }
 
-
-// LD Vx, DT
-// Set Vx = delay timer value
-void Chip8::OP_Fx07() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-
-    registers[Vx] = delay_timer;
+static uint8_t timerValue(uint8_t value, uint64_t setTick, uint64_t currentTick) {
+    uint64_t elapsed = currentTick - setTick;
+    return elapsed >= value ? 0 : static_cast<uint8_t>(value - elapsed);
 }
 
-
-// LD Vx, K
-// Wait for a key press, store the value of the key in Vx
-void Chip8::OP_Fx0A() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-
-    for (int i = 0; i < size(keypad); i++) {
-        if (keypad[i]) {
-            registers[Vx] = i;
-            return;
-        }
-    }
-    pc -= 2;
+uint8_t Chip8::GetDelayTimer() const {
+    return timerValue(delay_timer, delay_timer_tick, CurrentTick());
 }
 
-
-// LD DT, Vx
-// Set delay timer = Vx
-void Chip8::OP_Fx15() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-
-    delay_timer = registers[Vx];
+uint8_t Chip8::DelayTimerAt(uint64_t tick) const {
+    return timerValue(delay_timer, delay_timer_tick, tick);
 }
 
-
-// LD ST, Vx
-// Set sound timer = Vx
-void Chip8::OP_Fx18() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-
-    sound_timer = registers[Vx];
+uint8_t Chip8::GetSoundTimer() const {
+    return timerValue(sound_timer, sound_timer_tick, CurrentTick());
 }
 
-
-// ADD I, Vx
-// Set I = I + Vx
-void Chip8::OP_Fx1E() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-
-    index += registers[Vx];
+void Chip8::SetDelayTimer(uint8_t value) {
+    delay_timer = value;
+    delay_timer_tick = CurrentTick();
 }
 
-
-// LD F, Vx
-// Set I = location of sprite for digit Vx
-void Chip8::OP_Fx29() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-    index = memory[FONTSET_START_ADDRESS + (registers[Vx] * 5)];
-
-}
-
-
-// LD B, Vx
-// Store BCD representation of Vx in memory locations I, I+1, and I+2
-//
-//The interpreter takes the decimal value of Vx, and places the hundreds digit in memory
-// at location in I, the tens digit at location I+1, and the ones digit at location I+2
-void Chip8::OP_Fx33() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-
-    uint8_t value = registers[Vx];
-
-    memory[index + 2] = value % 10;
-    value /= 10;
-
-    memory[index + 1] = value % 10;
-    value /= 10;
-
-    memory[index] = value % 10;
-
-
+void Chip8::SetSoundTimer(uint8_t value) {
+    sound_timer = value;
+    sound_timer_tick = CurrentTick();
 }
 
-
-// LD [I], Vx
-// Store registers V0 through Vx in memory starting at location I.
-void Chip8::OP_Fx55() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-
-    for (uint8_t i = 0; i <= Vx; i++) {
-        memory[index + i] = registers[i];
-    }
-
+bool Chip8::WaitingForKey() const {
+    uint16_t next = memory.ReadOpcode(pc);
+    return (next & 0xF0FFu) == 0xF00Au && keypad.load(memory_order_relaxed) == 0;
 }
 
-
-// LD Vx, [I]
-// Read registers V0 through Vx from memory starting at location I
-void Chip8::OP_Fx65() {
-    uint8_t Vx = (opcode & 0x0F00u) >> 8u;
-
-    for (uint8_t i = 0; i <= Vx; i++) {
-        registers[i] = memory[index + i];
-    }
-
+void Chip8::AdvanceClock(uint64_t cycles) {
+    cycle_count += cycles;
 }
 
-
+// Instruction Set
+// Handlers decode their operands from the current opcode, the semantics live in Instructions.h
+
+using namespace Instructions;
+
+void Chip8::OP_00E0() { Instructions::OP_00E0(*this); }
+void Chip8::OP_00EE() { Instructions::OP_00EE(*this); }
+void Chip8::OP_1nnn() { Instructions::OP_1nnn(*this, nnn(opcode)); }
+void Chip8::OP_2nnn() { Instructions::OP_2nnn(*this, nnn(opcode)); }
+void Chip8::OP_3xkk() { Instructions::OP_3xkk(*this, Vx(opcode), kk(opcode)); }
+void Chip8::OP_4xkk() { Instructions::OP_4xkk(*this, Vx(opcode), kk(opcode)); }
+void Chip8::OP_5xy0() { Instructions::OP_5xy0(*this, Vx(opcode), Vy(opcode)); }
+void Chip8::OP_6xkk() { Instructions::OP_6xkk(*this, Vx(opcode), kk(opcode)); }
+void Chip8::OP_7xkk() { Instructions::OP_7xkk(*this, Vx(opcode), kk(opcode)); }
+void Chip8::OP_8xy0() { Instructions::OP_8xy0(*this, Vx(opcode), Vy(opcode)); }
+void Chip8::OP_8xy1() { Instructions::OP_8xy1(*this, Vx(opcode), Vy(opcode)); }
+void Chip8::OP_8xy2() { Instructions::OP_8xy2(*this, Vx(opcode), Vy(opcode)); }
+void Chip8::OP_8xy3() { Instructions::OP_8xy3(*this, Vx(opcode), Vy(opcode)); }
+void Chip8::OP_8xy4() { Instructions::OP_8xy4(*this, Vx(opcode), Vy(opcode)); }
+void Chip8::OP_8xy5() { Instructions::OP_8xy5(*this, Vx(opcode), Vy(opcode)); }
+void Chip8::OP_8xy6() { Instructions::OP_8xy6(*this, Vx(opcode)); }
+void Chip8::OP_8xy7() { Instructions::OP_8xy7(*this, Vx(opcode), Vy(opcode)); }
+void Chip8::OP_8xyE() { Instructions::OP_8xyE(*this, Vx(opcode)); }
+void Chip8::OP_9xy0() { Instructions::OP_9xy0(*this, Vx(opcode), Vy(opcode)); }
+void Chip8::OP_Annn() { Instructions::OP_Annn(*this, nnn(opcode)); }
+void Chip8::OP_Bnnn() { Instructions::OP_Bnnn(*this, nnn(opcode)); }
+void Chip8::OP_Cxkk() { Instructions::OP_Cxkk(*this, Vx(opcode), kk(opcode)); }
+void Chip8::OP_Dxyn() { Instructions::OP_Dxyn(*this, Vx(opcode), Vy(opcode), n(opcode)); }
+void Chip8::OP_Ex9E() { Instructions::OP_Ex9E(*this, Vx(opcode)); }
+void Chip8::OP_ExA1() { Instructions::OP_ExA1(*this, Vx(opcode)); }
+void Chip8::OP_Fx07() { Instructions::OP_Fx07(*this, Vx(opcode)); }
+void Chip8::OP_Fx0A() { Instructions::OP_Fx0A(*this, Vx(opcode)); }
+void Chip8::OP_Fx15() { Instructions::OP_Fx15(*this, Vx(opcode)); }
+void Chip8::OP_Fx18() { Instructions::OP_Fx18(*this, Vx(opcode)); }
+void Chip8::OP_Fx1E() { Instructions::OP_Fx1E(*this, Vx(opcode)); }
+void Chip8::OP_Fx29() { Instructions::OP_Fx29(*this, Vx(opcode)); }
+void Chip8::OP_Fx33() { Instructions::OP_Fx33(*this, Vx(opcode)); }
+void Chip8::OP_Fx55() { Instructions::OP_Fx55(*this, Vx(opcode)); }
+void Chip8::OP_Fx65() { Instructions::OP_Fx65(*this, Vx(opcode)); }
 
 // Master Tables for opcode translation
 
@@ -488,6 +305,7 @@ void Chip8::opcode_translation(uint16_t opcode) {
                     OP_NULL();
                     break;
             }
+            break;
         }
         case 0x8: {
             uint8_t last_digit = opcode & 0x000Fu;
@@ -620,76 +438,61 @@ void Chip8::opcode_translation(uint16_t opcode) {
 }
 
 
-void Chip8::Cycle() {
-
-    // Fetch the next instruction
-    opcode = (memory[pc] << 8u) | memory[pc + 1];
-
-    pc += 2;
-
-    //Translate opcode into function
-    //uint8_t first_digit = (opcode & 0xF000u) >> 12u;
-    //((*this).*(table[first_digit]))();
-    opcode_translation(opcode);
-
-    // Decrement timers
-    if (delay_timer > 0) {
-        --delay_timer;
-    }
-
-    if (sound_timer > 0) {
-        --sound_timer;
+// Hash of the full machine state, used to check that dispatch backends agree
+uint64_t Chip8::StateHash() const {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](void const *data, size_t size) {
+        auto bytes = static_cast<uint8_t const *>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+
+    mix(registers, sizeof(registers));
+    uint8_t bytes[PagedMemory::SIZE];
+    memory.Load(0, bytes, sizeof(bytes));
+    mix(bytes, sizeof(bytes));
+    mix(&index, sizeof(index));
+    mix(&pc, sizeof(pc));
+    mix(stack, sizeof(stack));
+    mix(&sp, sizeof(sp));
+    mix(display, sizeof(display));
+    mix(&cycle_count, sizeof(cycle_count));
+    uint8_t timers[2] = {GetDelayTimer(), GetSoundTimer()};
+    mix(timers, sizeof(timers));
+    mix(&rng.state, sizeof(rng.state));
+
+    return hash;
+}
+
+void Chip8::ExpandDisplay(uint32_t *pixels) const {
+    GetExpandKernel(ExpandIsa::Scalar)(display, VIDEO_HEIGHT, pixels, VIDEO_WIDTH * sizeof(uint32_t), 1,
+                                       DEFAULT_PALETTE);
+}
+
+// Hash of the presented RGBA pixels, so it doesn't depend on how the display is stored
+uint64_t Chip8::FramebufferHash() const {
+    uint32_t pixels[64 * 32];
+    ExpandDisplay(pixels);
+
+    uint64_t hash = 14695981039346656037ull;
+    auto bytes = reinterpret_cast<uint8_t const *>(pixels);
+    for (size_t i = 0; i < sizeof(pixels); ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
     }
-
+    return hash;
 }
 
 
-int main(int argc, char *argv[]) {
-    //spdlog::set_level(spdlog::level::debug);
-    Chip8 chip8;
-
-    if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <ROM> <Scale> <Delay>\n";
-        std::exit(EXIT_FAILURE);
-    }
-
-    char const *rom_filename = argv[1];
-    unsigned int scale = chip8.DEFAULT_SCALE;
-    unsigned int delay = chip8.DEFAULT_DELAY;
-
-    if (argc > 2) {
-        scale = stoi(argv[2]);
-    }
-    if (argc > 3) {
-        delay = stoi(argv[3]);
-    }
-
-    Platform platform("CHIP-8 Emulator", chip8.VIDEO_WIDTH * scale, chip8.VIDEO_HEIGHT * scale, chip8.VIDEO_WIDTH,
-                      chip8.VIDEO_HEIGHT);
-
-    chip8.LoadROM(rom_filename);
-
-    int videoPitch = sizeof(chip8.display[0]) * chip8.VIDEO_WIDTH;
-    auto lastCycleTime = std::chrono::high_resolution_clock::now();
-    bool quit = false;
-
-    while (!quit) {
-        quit = platform.ProcessInput(chip8.keypad);
-
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        float dt = std::chrono::duration<float, std::chrono::milliseconds::period>(
-                currentTime - lastCycleTime).count();
-
-        if (dt > delay) {
-            lastCycleTime = currentTime;
+void Chip8::Cycle() {
 
-            chip8.Cycle();
+    // Fetch the next instruction
+    opcode = Fetch(*this);
 
-            platform.Update(chip8.display, videoPitch);
-        }
-    }
+    //Translate opcode into function
+    opcode_translation(opcode);
 
-    return 0;
+    // Advance the virtual clock, timers are read from it lazily
+    ++cycle_count;
 
 }
-
@@ -6,38 +6,65 @@
 #define CHIP8_INTERPRETER_CHIP8_H
 
 #include <cstdint>
-#include <random>
 #include <cstring>
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include "Random.h"
+#include "PagedMemory.h"
 
 using namespace std;
 
-class Chip8 {
-public:
-    Chip8();
-
-    uint8_t registers[16]{};
-    uint8_t memory[4096]{};
-    uint16_t index{};
-    uint16_t pc{};
-    uint16_t stack[16]{};
-    uint8_t sp{};
-    uint8_t delay_timer{};
-    uint8_t sound_timer{};
-    uint8_t keypad[16]{};
-    uint32_t display[64 * 32]{};
-    uint16_t opcode;
+// Instruction dispatch strategies, all executing the same instruction set
+enum class DispatchMode {
+    Switch,     // Nested switch on the opcode digits
+    Table,      // Member function pointer tables
+    Threaded,   // Computed goto threaded code (GCC/Clang only, otherwise falls back to Switch)
+    TailCall,   // Handlers tail-calling the next handler (musttail where the compiler supports it)
+    Specialized,// 64K-entry table of handlers with operands baked in (compact tables with CHIP8_COMPACT_OPCODE_TABLE)
+    Cached,     // Pre-decoded instruction cache, invalidated by writes to guest memory
+    Blocks,     // Basic-block translation cache, one dispatch per straight-line run of instructions
+    Jit,        // x86-64 dynamic recompiler for hot blocks (interpreted on other hosts)
+    Aot         // ROM compiled ahead of time by chip8_aot and linked in (interpreted when none matches)
+};
 
+char const *DispatchModeName(DispatchMode mode);
+bool ParseDispatchMode(string const &name, DispatchMode &mode);
+vector<DispatchMode> DispatchModes();
 
-    const unsigned int START_ADDRESS = 0x200;
-    const unsigned int VIDEO_WIDTH = 64;
-    const unsigned int VIDEO_HEIGHT = 32;
+// Non-negative decimal count from the command line, false for anything else (signs, trailing text, overflow)
+bool ParseCount(string const &text, uint64_t &count);
+// 64-bit seed, decimal or 0x hex, false for anything else
+bool ParseSeed(string const &text, uint64_t &seed);
 
-    const unsigned int DEFAULT_SCALE = 10;
-    const unsigned int DEFAULT_DELAY = 5;
+class Chip8;
+class DecodeCache;
+class BlockCache;
+class Jit;
+class AotRunner;
+typedef void (Chip8::*Chip8Func)();
 
-    const unsigned int FONTSET_START_ADDRESS = 0x50;
-    static const unsigned int FONTSET_SIZE = 80;
-    uint8_t fontset[FONTSET_SIZE] =
+class Chip8 {
+public:
+    Chip8();
+    ~Chip8();
+
+    static constexpr unsigned int START_ADDRESS = 0x200;
+    static constexpr unsigned int VIDEO_WIDTH = 64;
+    static constexpr unsigned int VIDEO_HEIGHT = 32;
+
+    static constexpr unsigned int DEFAULT_SCALE = 10;
+    static constexpr unsigned int DEFAULT_CYCLES_PER_FRAME = 10;
+    // Command-line limit, far above anything playable, that keeps the clock rate in an unsigned int
+    static constexpr unsigned int MAX_CYCLES_PER_FRAME = 1000000;
+    static constexpr unsigned int FRAME_RATE = 60;
+    static constexpr unsigned int TIMER_RATE = 60;
+
+    // One font table shared by every instance, laid out in guest memory by MakeImage() and LoadFontset()
+    static constexpr unsigned int FONTSET_START_ADDRESS = 0x50;
+    static constexpr unsigned int FONTSET_SIZE = 80;
+    static constexpr uint8_t FONTSET[FONTSET_SIZE] =
             {
                     0xF0, 0x90, 0x90, 0x90, 0xF0, // 0
                     0x20, 0x60, 0x20, 0x20, 0x70, // 1
@@ -57,11 +84,91 @@ public:
                     0xF0, 0x80, 0xF0, 0x80, 0x80  // F
             };
 
-    void LoadROM(char const *filename);
+    // Hot state, read or written by nearly every instruction: exactly one cache line
+    alignas(64) uint8_t registers[16]{};
+    uint16_t pc{};
+    uint16_t index{};
+    uint16_t opcode{};
+    uint8_t sp{};
+    // Virtual clock: timers are derived from the instruction count instead of being decremented every cycle
+    uint64_t cycle_count{};
+    uint16_t stack[16]{};
+
+    // Timer values as last written, and the tick they were written at
+    uint8_t delay_timer{};
+    uint8_t sound_timer{};
+    // Pressed keys, bit k for key k
+    atomic<uint16_t> keypad{0};
+    // Display rows changed since the frontend last presented, bit y for row y
+    uint32_t dirty_rows = 0xFFFFFFFF;
+    uint64_t delay_timer_tick{};
+    uint64_t sound_timer_tick{};
+    uint64_t clock_base_cycle{};
+    uint64_t clock_base_tick{};
+    unsigned int cycles_per_second{};
+    // Record key_read_cycle and draw_cycle, only for --latency: every other run skips the stores
+    bool trace_latency = false;
+
+    // One bit per pixel, one word per row, column 0 in the most significant bit
+    alignas(64) uint64_t display[32]{};
+
+    // Font and ROM pages shared with every instance loaded from the same image, see PagedMemory.h
+    alignas(64) PagedMemory memory;
+
+    // Cold: only touched when trace_latency is set
+    // First cycle each key was read at since it was last reset, and the last cycle that drew
+    uint64_t key_read_cycle[16]{};
+    uint64_t draw_cycle{};
+
+    // False when the file can't be read
+    bool LoadROM(char const *filename);
+    // Load a ROM image already in memory, for runs that share one image across many instances
+    void LoadROM(uint8_t const *data, size_t size);
+    // Guest memory with the font and a ROM loaded, for LoadImage() to share between instances
+    static PagedMemory MakeImage(uint8_t const *data, size_t size);
+    void LoadImage(PagedMemory const &image);
 
     void LoadFontset();
 
-    uint8_t getRandomByte();
+    // Expand the display to one RGBA pixel per bit for presentation
+    void ExpandDisplay(uint32_t *pixels) const;
+
+    // Independent copy of the machine state, backend settings included. Memory pages stay shared until either side
+    // writes to them, so a fork costs about as much as copying the registers and display.
+    unique_ptr<Chip8> Fork() const;
+    // Overwrite this instance's machine state with parent's, keeping its own backend settings, so searches can reuse
+    // discarded children instead of allocating new ones
+    void ForkFrom(Chip8 const &parent);
+
+    // Must be called after anything writes to memory, so cached translations of that code are dropped
+    void MemoryWritten(uint16_t address, uint16_t length);
+    // Same after all of memory was replaced. The AOT runner checks its blocks against the new memory instead of
+    // giving them up for good.
+    void MemoryReplaced();
+
+    // Restart the random number generator; instances given different streams draw independent sequences
+    void Seed(uint64_t seed, uint64_t stream = Pcg32::DEFAULT_STREAM);
+
+    uint8_t getRandomByte() {
+        return rng.NextByte();
+    }
+
+    // Timers
+    void SetClockRate(unsigned int cyclesPerSecond);
+    uint64_t CurrentTick() const;
+    uint64_t TickAt(uint64_t cycle) const;
+    // First cycle at which the clock has reached tick
+    uint64_t CycleAtTick(uint64_t tick) const;
+    uint8_t DelayTimerAt(uint64_t tick) const;
+    uint8_t GetDelayTimer() const;
+    uint8_t GetSoundTimer() const;
+    void SetDelayTimer(uint8_t value);
+    void SetSoundTimer(uint8_t value);
+
+    // Fx0A is waiting with no key down: running more instructions would only advance the clock
+    bool WaitingForKey() const;
+    // Let cycles of emulated time pass without executing anything, as a spinning Fx0A would
+    void AdvanceClock(uint64_t cycles);
 
     // Instruction set
     void OP_00E0();
@@ -104,14 +211,40 @@ public:
 
     void opcode_translation(uint16_t opcode);
 
+    // Function pointer tables for the Table dispatch mode
+    void Table0();
+    void Table8();
+    void TableE();
+    void TableF();
+
+    static Chip8Func table[0xF + 1];
+    static Chip8Func table0[0xF + 1];
+    static Chip8Func table8[0xF + 1];
+    static Chip8Func tableE[0xF + 1];
+    static Chip8Func tableF[0xFF + 1];
+
     // Main Cycle
     void Cycle();
 
+    // Execute a number of instructions with the selected dispatch backend, skipping delay-timer wait loops when
+    // skip_idle_loops is set (see IdleLoop.h)
+    DispatchMode dispatch_mode = DispatchMode::Switch;
+    bool skip_idle_loops = false;
+    void Run(unsigned int cycles);
+    void RunDispatch(unsigned int cycles);
+
+    unique_ptr<DecodeCache> decode_cache;
+    unique_ptr<BlockCache> block_cache;
+    unique_ptr<Jit> jit;
+    unique_ptr<AotRunner> aot;
+
+    uint64_t StateHash() const;
+    uint64_t FramebufferHash() const;
+
 
 
 
-    default_random_engine randGen;
-    uniform_int_distribution<int> randByte;
+    Pcg32 rng;
 
 
 };
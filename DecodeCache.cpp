@@ -0,0 +1,141 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "DecodeCache.h"
+#include "Instructions.h"
+
+using namespace Instructions;
+
+static void D_NULL(Chip8 &, DecodedInstruction const &) {}
+static void D_00E0(Chip8 &c, DecodedInstruction const &) { OP_00E0(c); }
+static void D_00EE(Chip8 &c, DecodedInstruction const &) { OP_00EE(c); }
+static void D_1nnn(Chip8 &c, DecodedInstruction const &d) { OP_1nnn(c, d.nnn); }
+static void D_2nnn(Chip8 &c, DecodedInstruction const &d) { OP_2nnn(c, d.nnn); }
+static void D_3xkk(Chip8 &c, DecodedInstruction const &d) { OP_3xkk(c, d.x, d.kk); }
+static void D_4xkk(Chip8 &c, DecodedInstruction const &d) { OP_4xkk(c, d.x, d.kk); }
+static void D_5xy0(Chip8 &c, DecodedInstruction const &d) { OP_5xy0(c, d.x, d.y); }
+static void D_6xkk(Chip8 &c, DecodedInstruction const &d) { OP_6xkk(c, d.x, d.kk); }
+static void D_7xkk(Chip8 &c, DecodedInstruction const &d) { OP_7xkk(c, d.x, d.kk); }
+static void D_8xy0(Chip8 &c, DecodedInstruction const &d) { OP_8xy0(c, d.x, d.y); }
+static void D_8xy1(Chip8 &c, DecodedInstruction const &d) { OP_8xy1(c, d.x, d.y); }
+static void D_8xy2(Chip8 &c, DecodedInstruction const &d) { OP_8xy2(c, d.x, d.y); }
+static void D_8xy3(Chip8 &c, DecodedInstruction const &d) { OP_8xy3(c, d.x, d.y); }
+static void D_8xy4(Chip8 &c, DecodedInstruction const &d) { OP_8xy4(c, d.x, d.y); }
+static void D_8xy5(Chip8 &c, DecodedInstruction const &d) { OP_8xy5(c, d.x, d.y); }
+static void D_8xy6(Chip8 &c, DecodedInstruction const &d) { OP_8xy6(c, d.x); }
+static void D_8xy7(Chip8 &c, DecodedInstruction const &d) { OP_8xy7(c, d.x, d.y); }
+static void D_8xyE(Chip8 &c, DecodedInstruction const &d) { OP_8xyE(c, d.x); }
+static void D_9xy0(Chip8 &c, DecodedInstruction const &d) { OP_9xy0(c, d.x, d.y); }
+static void D_Annn(Chip8 &c, DecodedInstruction const &d) { OP_Annn(c, d.nnn); }
+static void D_Bnnn(Chip8 &c, DecodedInstruction const &d) { OP_Bnnn(c, d.nnn); }
+static void D_Cxkk(Chip8 &c, DecodedInstruction const &d) { OP_Cxkk(c, d.x, d.kk); }
+static void D_Dxyn(Chip8 &c, DecodedInstruction const &d) { OP_Dxyn(c, d.x, d.y, d.n); }
+static void D_Ex9E(Chip8 &c, DecodedInstruction const &d) { OP_Ex9E(c, d.x); }
+static void D_ExA1(Chip8 &c, DecodedInstruction const &d) { OP_ExA1(c, d.x); }
+static void D_Fx07(Chip8 &c, DecodedInstruction const &d) { OP_Fx07(c, d.x); }
+static void D_Fx0A(Chip8 &c, DecodedInstruction const &d) { OP_Fx0A(c, d.x); }
+static void D_Fx15(Chip8 &c, DecodedInstruction const &d) { OP_Fx15(c, d.x); }
+static void D_Fx18(Chip8 &c, DecodedInstruction const &d) { OP_Fx18(c, d.x); }
+static void D_Fx1E(Chip8 &c, DecodedInstruction const &d) { OP_Fx1E(c, d.x); }
+static void D_Fx29(Chip8 &c, DecodedInstruction const &d) { OP_Fx29(c, d.x); }
+static void D_Fx33(Chip8 &c, DecodedInstruction const &d) { OP_Fx33(c, d.x); }
+static void D_Fx55(Chip8 &c, DecodedInstruction const &d) { OP_Fx55(c, d.x); }
+static void D_Fx65(Chip8 &c, DecodedInstruction const &d) { OP_Fx65(c, d.x); }
+
+static DecodedHandler decodedHandler(uint16_t opcode) {
+    switch (opcode >> 12u) {
+        case 0x0:
+            switch (opcode & 0x000Fu) {
+                case 0x0: return D_00E0;
+                case 0xE: return D_00EE;
+                default: return D_NULL;
+            }
+        case 0x1: return D_1nnn;
+        case 0x2: return D_2nnn;
+        case 0x3: return D_3xkk;
+        case 0x4: return D_4xkk;
+        case 0x5: return D_5xy0;
+        case 0x6: return D_6xkk;
+        case 0x7: return D_7xkk;
+        case 0x8:
+            switch (opcode & 0x000Fu) {
+                case 0x0: return D_8xy0;
+                case 0x1: return D_8xy1;
+                case 0x2: return D_8xy2;
+                case 0x3: return D_8xy3;
+                case 0x4: return D_8xy4;
+                case 0x5: return D_8xy5;
+                case 0x6: return D_8xy6;
+                case 0x7: return D_8xy7;
+                case 0xE: return D_8xyE;
+                default: return D_NULL;
+            }
+        case 0x9: return D_9xy0;
+        case 0xA: return D_Annn;
+        case 0xB: return D_Bnnn;
+        case 0xC: return D_Cxkk;
+        case 0xD: return D_Dxyn;
+        case 0xE:
+            switch (opcode & 0x000Fu) {
+                case 0xE: return D_Ex9E;
+                case 0x1: return D_ExA1;
+                default: return D_NULL;
+            }
+        default:
+            switch (opcode & 0x00FFu) {
+                case 0x07: return D_Fx07;
+                case 0x0A: return D_Fx0A;
+                case 0x15: return D_Fx15;
+                case 0x18: return D_Fx18;
+                case 0x1E: return D_Fx1E;
+                case 0x29: return D_Fx29;
+                case 0x33: return D_Fx33;
+                case 0x55: return D_Fx55;
+                case 0x65: return D_Fx65;
+                default: return D_NULL;
+            }
+    }
+}
+
+DecodedInstruction Decode(uint16_t opcode) {
+    DecodedInstruction instruction{};
+    instruction.handler = decodedHandler(opcode);
+    instruction.opcode = opcode;
+    instruction.nnn = nnn(opcode);
+    instruction.x = Vx(opcode);
+    instruction.y = Vy(opcode);
+    instruction.kk = kk(opcode);
+    instruction.n = n(opcode);
+    return instruction;
+}
+
+// Placeholder for addresses that have not been decoded yet: decode, remember and execute
+static void D_Decode(Chip8 &c, DecodedInstruction const &) {
+    uint16_t address = (c.pc - 2) & 0x0FFFu;
+    uint16_t opcode = c.memory.ReadOpcode(address);
+
+    DecodedInstruction &entry = c.decode_cache->entries[address];
+    entry = Decode(opcode);
+    entry.handler(c, entry);
+}
+
+DecodeCache::DecodeCache() {
+    Invalidate(0, sizeof(entries) / sizeof(entries[0]));
+}
+
+void DecodeCache::Run(Chip8 &c, unsigned int cycles) {
+    for (unsigned int i = 0; i < cycles; ++i) {
+        DecodedInstruction const &instruction = entries[c.pc & 0x0FFFu];
+        c.pc += 2;
+        instruction.handler(c, instruction);
+        ++c.cycle_count;
+    }
+}
+
+void DecodeCache::Invalidate(uint16_t address, uint16_t length) {
+    // An instruction starting one byte before the write overlaps it too
+    for (int i = -1; i < length; ++i) {
+        entries[(address + i) & 0x0FFFu].handler = D_Decode;
+    }
+}
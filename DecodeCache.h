@@ -0,0 +1,39 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_DECODECACHE_H
+#define CHIP8_INTERPRETER_DECODECACHE_H
+
+#include "Chip8.h"
+
+struct DecodedInstruction;
+typedef void (*DecodedHandler)(Chip8 &c, DecodedInstruction const &instruction);
+
+// An instruction with its operands unpacked, ready to execute without touching memory[]
+struct DecodedInstruction {
+    DecodedHandler handler;
+    uint16_t opcode;
+    uint16_t nnn;
+    uint8_t x;
+    uint8_t y;
+    uint8_t kk;
+    uint8_t n;
+};
+
+DecodedInstruction Decode(uint16_t opcode);
+
+// Pre-decoded copy of the address space, one entry per address, filled the first time an address is executed.
+// Writes to guest memory invalidate the entries they overlap, so self-modifying code is picked up again.
+class DecodeCache {
+public:
+    DecodeCache();
+
+    void Run(Chip8 &c, unsigned int cycles);
+
+    void Invalidate(uint16_t address, uint16_t length);
+
+    DecodedInstruction entries[4096];
+};
+
+#endif //CHIP8_INTERPRETER_DECODECACHE_H
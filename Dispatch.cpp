@@ -0,0 +1,442 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "Chip8.h"
+#include "Instructions.h"
+#include "OpcodeTable.h"
+#include "DecodeCache.h"
+#include "BlockCache.h"
+#include "Jit.h"
+#include "AotRuntime.h"
+#include "IdleLoop.h"
+
+using namespace Instructions;
+
+// Table dispatch
+
+Chip8Func Chip8::table[0xF + 1];
+Chip8Func Chip8::table0[0xF + 1];
+Chip8Func Chip8::table8[0xF + 1];
+Chip8Func Chip8::tableE[0xF + 1];
+Chip8Func Chip8::tableF[0xFF + 1];
+
+static bool initTables() {
+    for (auto &entry: Chip8::table0) entry = &Chip8::OP_NULL;
+    for (auto &entry: Chip8::table8) entry = &Chip8::OP_NULL;
+    for (auto &entry: Chip8::tableE) entry = &Chip8::OP_NULL;
+    for (auto &entry: Chip8::tableF) entry = &Chip8::OP_NULL;
+
+    Chip8::table[0x0] = &Chip8::Table0;
+    Chip8::table[0x1] = &Chip8::OP_1nnn;
+    Chip8::table[0x2] = &Chip8::OP_2nnn;
+    Chip8::table[0x3] = &Chip8::OP_3xkk;
+    Chip8::table[0x4] = &Chip8::OP_4xkk;
+    Chip8::table[0x5] = &Chip8::OP_5xy0;
+    Chip8::table[0x6] = &Chip8::OP_6xkk;
+    Chip8::table[0x7] = &Chip8::OP_7xkk;
+    Chip8::table[0x8] = &Chip8::Table8;
+    Chip8::table[0x9] = &Chip8::OP_9xy0;
+    Chip8::table[0xA] = &Chip8::OP_Annn;
+    Chip8::table[0xB] = &Chip8::OP_Bnnn;
+    Chip8::table[0xC] = &Chip8::OP_Cxkk;
+    Chip8::table[0xD] = &Chip8::OP_Dxyn;
+    Chip8::table[0xE] = &Chip8::TableE;
+    Chip8::table[0xF] = &Chip8::TableF;
+
+    Chip8::table0[0x0] = &Chip8::OP_00E0;
+    Chip8::table0[0xE] = &Chip8::OP_00EE;
+
+    Chip8::table8[0x0] = &Chip8::OP_8xy0;
+    Chip8::table8[0x1] = &Chip8::OP_8xy1;
+    Chip8::table8[0x2] = &Chip8::OP_8xy2;
+    Chip8::table8[0x3] = &Chip8::OP_8xy3;
+    Chip8::table8[0x4] = &Chip8::OP_8xy4;
+    Chip8::table8[0x5] = &Chip8::OP_8xy5;
+    Chip8::table8[0x6] = &Chip8::OP_8xy6;
+    Chip8::table8[0x7] = &Chip8::OP_8xy7;
+    Chip8::table8[0xE] = &Chip8::OP_8xyE;
+
+    Chip8::tableE[0x1] = &Chip8::OP_ExA1;
+    Chip8::tableE[0xE] = &Chip8::OP_Ex9E;
+
+    Chip8::tableF[0x07] = &Chip8::OP_Fx07;
+    Chip8::tableF[0x0A] = &Chip8::OP_Fx0A;
+    Chip8::tableF[0x15] = &Chip8::OP_Fx15;
+    Chip8::tableF[0x18] = &Chip8::OP_Fx18;
+    Chip8::tableF[0x1E] = &Chip8::OP_Fx1E;
+    Chip8::tableF[0x29] = &Chip8::OP_Fx29;
+    Chip8::tableF[0x33] = &Chip8::OP_Fx33;
+    Chip8::tableF[0x55] = &Chip8::OP_Fx55;
+    Chip8::tableF[0x65] = &Chip8::OP_Fx65;
+
+    return true;
+}
+
+static bool tablesInitialized = initTables();
+
+void Chip8::Table0() {
+    ((*this).*(table0[opcode & 0x000Fu]))();
+}
+
+void Chip8::Table8() {
+    ((*this).*(table8[opcode & 0x000Fu]))();
+}
+
+void Chip8::TableE() {
+    ((*this).*(tableE[opcode & 0x000Fu]))();
+}
+
+void Chip8::TableF() {
+    ((*this).*(tableF[opcode & 0x00FFu]))();
+}
+
+
+// Threaded dispatch
+// Every handler jumps straight to the next one through a label table instead of returning to a loop
+
+#if defined(__GNUC__)
+
+static void RunThreaded(Chip8 &c, unsigned int cycles) {
+    static void *const labels[0xF + 1] = {
+            &&group_0, &&op_1nnn, &&op_2nnn, &&op_3xkk, &&op_4xkk, &&op_5xy0, &&op_6xkk, &&op_7xkk,
+            &&group_8, &&op_9xy0, &&op_Annn, &&op_Bnnn, &&op_Cxkk, &&op_Dxyn, &&group_E, &&group_F
+    };
+    static void *const labels0[0xF + 1] = {
+            &&op_00E0, &&op_null, &&op_null, &&op_null, &&op_null, &&op_null, &&op_null, &&op_null,
+            &&op_null, &&op_null, &&op_null, &&op_null, &&op_null, &&op_null, &&op_00EE, &&op_null
+    };
+    static void *const labels8[0xF + 1] = {
+            &&op_8xy0, &&op_8xy1, &&op_8xy2, &&op_8xy3, &&op_8xy4, &&op_8xy5, &&op_8xy6, &&op_8xy7,
+            &&op_null, &&op_null, &&op_null, &&op_null, &&op_null, &&op_null, &&op_8xyE, &&op_null
+    };
+
+    uint16_t opcode;
+
+#define THREADED_NEXT()                           \
+    do {                                          \
+        ++c.cycle_count;                          \
+        if (--cycles == 0) return;                \
+        opcode = Fetch(c);                        \
+        goto *labels[opcode >> 12u];              \
+    } while (0)
+
+    if (cycles == 0) {
+        return;
+    }
+    opcode = Fetch(c);
+    goto *labels[opcode >> 12u];
+
+    group_0:
+    goto *labels0[opcode & 0x000Fu];
+    group_8:
+    goto *labels8[opcode & 0x000Fu];
+    group_E:
+    switch (opcode & 0x000Fu) {
+        case 0x1: goto op_ExA1;
+        case 0xE: goto op_Ex9E;
+        default: goto op_null;
+    }
+    group_F:
+    switch (opcode & 0x00FFu) {
+        case 0x07: goto op_Fx07;
+        case 0x0A: goto op_Fx0A;
+        case 0x15: goto op_Fx15;
+        case 0x18: goto op_Fx18;
+        case 0x1E: goto op_Fx1E;
+        case 0x29: goto op_Fx29;
+        case 0x33: goto op_Fx33;
+        case 0x55: goto op_Fx55;
+        case 0x65: goto op_Fx65;
+        default: goto op_null;
+    }
+
+    op_00E0: OP_00E0(c); THREADED_NEXT();
+    op_00EE: OP_00EE(c); THREADED_NEXT();
+    op_1nnn: OP_1nnn(c, nnn(opcode)); THREADED_NEXT();
+    op_2nnn: OP_2nnn(c, nnn(opcode)); THREADED_NEXT();
+    op_3xkk: OP_3xkk(c, Vx(opcode), kk(opcode)); THREADED_NEXT();
+    op_4xkk: OP_4xkk(c, Vx(opcode), kk(opcode)); THREADED_NEXT();
+    op_5xy0: OP_5xy0(c, Vx(opcode), Vy(opcode)); THREADED_NEXT();
+    op_6xkk: OP_6xkk(c, Vx(opcode), kk(opcode)); THREADED_NEXT();
+    op_7xkk: OP_7xkk(c, Vx(opcode), kk(opcode)); THREADED_NEXT();
+    op_8xy0: OP_8xy0(c, Vx(opcode), Vy(opcode)); THREADED_NEXT();
+    op_8xy1: OP_8xy1(c, Vx(opcode), Vy(opcode)); THREADED_NEXT();
+    op_8xy2: OP_8xy2(c, Vx(opcode), Vy(opcode)); THREADED_NEXT();
+    op_8xy3: OP_8xy3(c, Vx(opcode), Vy(opcode)); THREADED_NEXT();
+    op_8xy4: OP_8xy4(c, Vx(opcode), Vy(opcode)); THREADED_NEXT();
+    op_8xy5: OP_8xy5(c, Vx(opcode), Vy(opcode)); THREADED_NEXT();
+    op_8xy6: OP_8xy6(c, Vx(opcode)); THREADED_NEXT();
+    op_8xy7: OP_8xy7(c, Vx(opcode), Vy(opcode)); THREADED_NEXT();
+    op_8xyE: OP_8xyE(c, Vx(opcode)); THREADED_NEXT();
+    op_9xy0: OP_9xy0(c, Vx(opcode), Vy(opcode)); THREADED_NEXT();
+    op_Annn: OP_Annn(c, nnn(opcode)); THREADED_NEXT();
+    op_Bnnn: OP_Bnnn(c, nnn(opcode)); THREADED_NEXT();
+    op_Cxkk: OP_Cxkk(c, Vx(opcode), kk(opcode)); THREADED_NEXT();
+    op_Dxyn: OP_Dxyn(c, Vx(opcode), Vy(opcode), n(opcode)); THREADED_NEXT();
+    op_Ex9E: OP_Ex9E(c, Vx(opcode)); THREADED_NEXT();
+    op_ExA1: OP_ExA1(c, Vx(opcode)); THREADED_NEXT();
+    op_Fx07: OP_Fx07(c, Vx(opcode)); THREADED_NEXT();
+    op_Fx0A: OP_Fx0A(c, Vx(opcode)); THREADED_NEXT();
+    op_Fx15: OP_Fx15(c, Vx(opcode)); THREADED_NEXT();
+    op_Fx18: OP_Fx18(c, Vx(opcode)); THREADED_NEXT();
+    op_Fx1E: OP_Fx1E(c, Vx(opcode)); THREADED_NEXT();
+    op_Fx29: OP_Fx29(c, Vx(opcode)); THREADED_NEXT();
+    op_Fx33: OP_Fx33(c, Vx(opcode)); THREADED_NEXT();
+    op_Fx55: OP_Fx55(c, Vx(opcode)); THREADED_NEXT();
+    op_Fx65: OP_Fx65(c, Vx(opcode)); THREADED_NEXT();
+    op_null: THREADED_NEXT();
+
+#undef THREADED_NEXT
+}
+
+#else
+
+static void RunThreaded(Chip8 &c, unsigned int cycles) {
+    for (unsigned int i = 0; i < cycles; ++i) {
+        c.Cycle();
+    }
+}
+
+#endif
+
+
+// Tail-call dispatch
+// Each handler ends by calling the handler of the next instruction. With musttail the chain never grows the
+// stack; without it the handlers return after one instruction and a loop drives them instead.
+
+#if defined(__has_attribute)
+#if __has_attribute(musttail)
+#define CHIP8_MUSTTAIL __attribute__((musttail))
+#endif
+#endif
+
+typedef void (*TailHandler)(Chip8 &c, uint16_t opcode, unsigned int remaining);
+
+static void TailFetch(Chip8 &c, uint16_t opcode, unsigned int remaining);
+
+#ifdef CHIP8_MUSTTAIL
+#define TAIL_NEXT()                                                 \
+    do {                                                            \
+        ++c.cycle_count;                                            \
+        if (--remaining == 0) return;                               \
+        CHIP8_MUSTTAIL return TailFetch(c, 0, remaining);           \
+    } while (0)
+#define TAIL_JUMP(handler) CHIP8_MUSTTAIL return handler(c, opcode, remaining)
+#else
+#define TAIL_NEXT() do { ++c.cycle_count; return; } while (0)
+#define TAIL_JUMP(handler) return handler(c, opcode, remaining)
+#endif
+
+// Not every handler decodes operands, and only the musttail chain passes remaining on
+#define TAIL_HANDLER(name, ...)                                                                             \
+    static void TC_##name(Chip8 &c, [[maybe_unused]] uint16_t opcode, [[maybe_unused]] unsigned int remaining) { \
+        OP_##name(__VA_ARGS__);                                                                             \
+        TAIL_NEXT();                                                                                        \
+    }
+
+TAIL_HANDLER(00E0, c)
+TAIL_HANDLER(00EE, c)
+TAIL_HANDLER(1nnn, c, nnn(opcode))
+TAIL_HANDLER(2nnn, c, nnn(opcode))
+TAIL_HANDLER(3xkk, c, Vx(opcode), kk(opcode))
+TAIL_HANDLER(4xkk, c, Vx(opcode), kk(opcode))
+TAIL_HANDLER(5xy0, c, Vx(opcode), Vy(opcode))
+TAIL_HANDLER(6xkk, c, Vx(opcode), kk(opcode))
+TAIL_HANDLER(7xkk, c, Vx(opcode), kk(opcode))
+TAIL_HANDLER(8xy0, c, Vx(opcode), Vy(opcode))
+TAIL_HANDLER(8xy1, c, Vx(opcode), Vy(opcode))
+TAIL_HANDLER(8xy2, c, Vx(opcode), Vy(opcode))
+TAIL_HANDLER(8xy3, c, Vx(opcode), Vy(opcode))
+TAIL_HANDLER(8xy4, c, Vx(opcode), Vy(opcode))
+TAIL_HANDLER(8xy5, c, Vx(opcode), Vy(opcode))
+TAIL_HANDLER(8xy6, c, Vx(opcode))
+TAIL_HANDLER(8xy7, c, Vx(opcode), Vy(opcode))
+TAIL_HANDLER(8xyE, c, Vx(opcode))
+TAIL_HANDLER(9xy0, c, Vx(opcode), Vy(opcode))
+TAIL_HANDLER(Annn, c, nnn(opcode))
+TAIL_HANDLER(Bnnn, c, nnn(opcode))
+TAIL_HANDLER(Cxkk, c, Vx(opcode), kk(opcode))
+TAIL_HANDLER(Dxyn, c, Vx(opcode), Vy(opcode), n(opcode))
+TAIL_HANDLER(Ex9E, c, Vx(opcode))
+TAIL_HANDLER(ExA1, c, Vx(opcode))
+TAIL_HANDLER(Fx07, c, Vx(opcode))
+TAIL_HANDLER(Fx0A, c, Vx(opcode))
+TAIL_HANDLER(Fx15, c, Vx(opcode))
+TAIL_HANDLER(Fx18, c, Vx(opcode))
+TAIL_HANDLER(Fx1E, c, Vx(opcode))
+TAIL_HANDLER(Fx29, c, Vx(opcode))
+TAIL_HANDLER(Fx33, c, Vx(opcode))
+TAIL_HANDLER(Fx55, c, Vx(opcode))
+TAIL_HANDLER(Fx65, c, Vx(opcode))
+
+#undef TAIL_HANDLER
+
+static void TC_NULL(Chip8 &c, uint16_t, [[maybe_unused]] unsigned int remaining) {
+    TAIL_NEXT();
+}
+
+static void TC_Group0(Chip8 &c, uint16_t opcode, unsigned int remaining) {
+    static const TailHandler handlers[0xF + 1] = {
+            TC_00E0, TC_NULL, TC_NULL, TC_NULL, TC_NULL, TC_NULL, TC_NULL, TC_NULL,
+            TC_NULL, TC_NULL, TC_NULL, TC_NULL, TC_NULL, TC_NULL, TC_00EE, TC_NULL
+    };
+    TAIL_JUMP(handlers[opcode & 0x000Fu]);
+}
+
+static void TC_Group8(Chip8 &c, uint16_t opcode, unsigned int remaining) {
+    static const TailHandler handlers[0xF + 1] = {
+            TC_8xy0, TC_8xy1, TC_8xy2, TC_8xy3, TC_8xy4, TC_8xy5, TC_8xy6, TC_8xy7,
+            TC_NULL, TC_NULL, TC_NULL, TC_NULL, TC_NULL, TC_NULL, TC_8xyE, TC_NULL
+    };
+    TAIL_JUMP(handlers[opcode & 0x000Fu]);
+}
+
+static void TC_GroupE(Chip8 &c, uint16_t opcode, unsigned int remaining) {
+    switch (opcode & 0x000Fu) {
+        case 0x1: TAIL_JUMP(TC_ExA1);
+        case 0xE: TAIL_JUMP(TC_Ex9E);
+        default: TAIL_JUMP(TC_NULL);
+    }
+}
+
+static void TC_GroupF(Chip8 &c, uint16_t opcode, unsigned int remaining) {
+    switch (opcode & 0x00FFu) {
+        case 0x07: TAIL_JUMP(TC_Fx07);
+        case 0x0A: TAIL_JUMP(TC_Fx0A);
+        case 0x15: TAIL_JUMP(TC_Fx15);
+        case 0x18: TAIL_JUMP(TC_Fx18);
+        case 0x1E: TAIL_JUMP(TC_Fx1E);
+        case 0x29: TAIL_JUMP(TC_Fx29);
+        case 0x33: TAIL_JUMP(TC_Fx33);
+        case 0x55: TAIL_JUMP(TC_Fx55);
+        case 0x65: TAIL_JUMP(TC_Fx65);
+        default: TAIL_JUMP(TC_NULL);
+    }
+}
+
+static void TailFetch(Chip8 &c, uint16_t opcode, unsigned int remaining) {
+    static const TailHandler handlers[0xF + 1] = {
+            TC_Group0, TC_1nnn, TC_2nnn, TC_3xkk, TC_4xkk, TC_5xy0, TC_6xkk, TC_7xkk,
+            TC_Group8, TC_9xy0, TC_Annn, TC_Bnnn, TC_Cxkk, TC_Dxyn, TC_GroupE, TC_GroupF
+    };
+    opcode = Fetch(c);
+    TAIL_JUMP(handlers[opcode >> 12u]);
+}
+
+static void RunTailCall(Chip8 &c, unsigned int cycles) {
+#ifdef CHIP8_MUSTTAIL
+    if (cycles > 0) {
+        TailFetch(c, 0, cycles);
+    }
+#else
+    for (unsigned int i = 0; i < cycles; ++i) {
+        TailFetch(c, 0, 1);
+    }
+#endif
+}
+
+#undef TAIL_NEXT
+#undef TAIL_JUMP
+
+
+void Chip8::Run(unsigned int cycles) {
+    if (skip_idle_loops) {
+        RunSkippingIdleLoops(*this, cycles);
+    } else {
+        RunDispatch(cycles);
+    }
+}
+
+void Chip8::RunDispatch(unsigned int cycles) {
+    switch (dispatch_mode) {
+        case DispatchMode::Switch:
+            for (unsigned int i = 0; i < cycles; ++i) {
+                Cycle();
+            }
+            break;
+        case DispatchMode::Table:
+            for (unsigned int i = 0; i < cycles; ++i) {
+                opcode = Fetch(*this);
+                ((*this).*(table[opcode >> 12u]))();
+                ++cycle_count;
+            }
+            break;
+        case DispatchMode::Threaded:
+            RunThreaded(*this, cycles);
+            break;
+        case DispatchMode::TailCall:
+            RunTailCall(*this, cycles);
+            break;
+        case DispatchMode::Specialized:
+            RunSpecialized(*this, cycles);
+            break;
+        case DispatchMode::Cached:
+            if (!decode_cache) {
+                decode_cache = make_unique<DecodeCache>();
+            }
+            decode_cache->Run(*this, cycles);
+            break;
+        case DispatchMode::Blocks:
+            if (!block_cache) {
+                block_cache = make_unique<BlockCache>();
+            }
+            block_cache->Run(*this, cycles);
+            break;
+        case DispatchMode::Jit:
+            if (!jit) {
+                jit = make_unique<Jit>();
+            }
+            jit->Run(*this, cycles);
+            break;
+        case DispatchMode::Aot:
+            if (!aot) {
+                aot = make_unique<AotRunner>(*this);
+            }
+            aot->Run(*this, cycles);
+            break;
+    }
+}
+
+
+static const struct {
+    DispatchMode mode;
+    char const *name;
+} dispatchModeNames[] = {
+        {DispatchMode::Switch,      "switch"},
+        {DispatchMode::Table,       "table"},
+        {DispatchMode::Threaded,    "threaded"},
+        {DispatchMode::TailCall,    "tailcall"},
+        {DispatchMode::Specialized, "specialized"},
+        {DispatchMode::Cached,      "cached"},
+        {DispatchMode::Blocks,      "blocks"},
+        {DispatchMode::Jit,         "jit"},
+        {DispatchMode::Aot,         "aot"},
+};
+
+char const *DispatchModeName(DispatchMode mode) {
+    for (auto const &entry: dispatchModeNames) {
+        if (entry.mode == mode) {
+            return entry.name;
+        }
+    }
+    return "unknown";
+}
+
+bool ParseDispatchMode(string const &name, DispatchMode &mode) {
+    for (auto const &entry: dispatchModeNames) {
+        if (name == entry.name) {
+            mode = entry.mode;
+            return true;
+        }
+    }
+    return false;
+}
+
+vector<DispatchMode> DispatchModes() {
+    vector<DispatchMode> modes;
+    for (auto const &entry: dispatchModeNames) {
+        modes.push_back(entry.mode);
+    }
+    return modes;
+}
@@ -0,0 +1,174 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "DisplayExpand.h"
+#include <cstdio>
+#include <cstring>
+
+#ifdef CHIP8_EXPAND_X86
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define CHIP8_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CHIP8_TARGET_AVX2
+#endif
+#endif
+
+using namespace std;
+
+static const unsigned int DISPLAY_COLUMNS = 64;
+
+static inline uint32_t *RowAt(uint32_t *pixels, int pitch, unsigned int y) {
+    return reinterpret_cast<uint32_t *>(reinterpret_cast<uint8_t *>(pixels) + static_cast<ptrdiff_t>(pitch) * y);
+}
+
+// The first output row of a display row is expanded, the rest of its scale rows are copies
+static inline void ReplicateRow(uint32_t *pixels, int pitch, unsigned int y, unsigned int scale) {
+    uint32_t *first = RowAt(pixels, pitch, y * scale);
+    for (unsigned int i = 1; i < scale; ++i) {
+        std::memcpy(RowAt(pixels, pitch, y * scale + i), first, DISPLAY_COLUMNS * scale * sizeof(uint32_t));
+    }
+}
+
+// Pixels from column first to the end of the row, one at a time
+static inline void FillColumns(uint64_t row, unsigned int first, uint32_t *out, unsigned int scale, Palette palette) {
+    for (unsigned int x = first; x < DISPLAY_COLUMNS; ++x) {
+        uint32_t color = (row >> (63u - x)) & 1u ? palette.on : palette.off;
+        for (unsigned int i = 0; i < scale; ++i) {
+            *out++ = color;
+        }
+    }
+}
+
+static void ExpandScalar(uint64_t const *display, unsigned int rows, uint32_t *pixels, int pitch, unsigned int scale,
+                         Palette palette) {
+    for (unsigned int y = 0; y < rows; ++y) {
+        FillColumns(display[y], 0, RowAt(pixels, pitch, y * scale), scale, palette);
+        ReplicateRow(pixels, pitch, y, scale);
+    }
+}
+
+#ifdef CHIP8_EXPAND_X86
+
+// Scale 1: select between the two colors with a mask built from 4 (8 for AVX2) bits at a time.
+// Larger scales: fill each pixel's run with unaligned stores, letting the last store spill into the next run,
+// which overwrites it. The last few pixels of a row, whose stores would spill past the row, are done one at a time.
+static void ExpandSse2(uint64_t const *display, unsigned int rows, uint32_t *pixels, int pitch, unsigned int scale,
+                       Palette palette) {
+    const __m128i off = _mm_set1_epi32(static_cast<int>(palette.off));
+    const __m128i diff = _mm_set1_epi32(static_cast<int>(palette.on ^ palette.off));
+    const __m128i bits = _mm_setr_epi32(8, 4, 2, 1);
+
+    for (unsigned int y = 0; y < rows; ++y) {
+        uint64_t row = display[y];
+        uint32_t *out = RowAt(pixels, pitch, y * scale);
+
+        if (scale == 1) {
+            for (unsigned int x = 0; x < DISPLAY_COLUMNS; x += 4) {
+                __m128i nibble = _mm_set1_epi32(static_cast<int>((row >> (60u - x)) & 0xFu));
+                __m128i mask = _mm_cmpeq_epi32(_mm_and_si128(nibble, bits), bits);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out + x),
+                                 _mm_xor_si128(off, _mm_and_si128(mask, diff)));
+            }
+        } else {
+            unsigned int vectorColumns = DISPLAY_COLUMNS - (4 - 1 + scale - 1) / scale;
+            for (unsigned int x = 0; x < vectorColumns; ++x) {
+                uint32_t color = (row >> (63u - x)) & 1u ? palette.on : palette.off;
+                __m128i fill = _mm_set1_epi32(static_cast<int>(color));
+                for (unsigned int i = 0; i < scale; i += 4) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), fill);
+                }
+                out += scale;
+            }
+            FillColumns(row, vectorColumns, out, scale, palette);
+        }
+
+        ReplicateRow(pixels, pitch, y, scale);
+    }
+}
+
+CHIP8_TARGET_AVX2
+static void ExpandAvx2(uint64_t const *display, unsigned int rows, uint32_t *pixels, int pitch, unsigned int scale,
+                       Palette palette) {
+    const __m256i off = _mm256_set1_epi32(static_cast<int>(palette.off));
+    const __m256i diff = _mm256_set1_epi32(static_cast<int>(palette.on ^ palette.off));
+    const __m256i bits = _mm256_setr_epi32(128, 64, 32, 16, 8, 4, 2, 1);
+
+    for (unsigned int y = 0; y < rows; ++y) {
+        uint64_t row = display[y];
+        uint32_t *out = RowAt(pixels, pitch, y * scale);
+
+        if (scale == 1) {
+            for (unsigned int x = 0; x < DISPLAY_COLUMNS; x += 8) {
+                __m256i byte = _mm256_set1_epi32(static_cast<int>((row >> (56u - x)) & 0xFFu));
+                __m256i mask = _mm256_cmpeq_epi32(_mm256_and_si256(byte, bits), bits);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + x),
+                                    _mm256_xor_si256(off, _mm256_and_si256(mask, diff)));
+            }
+        } else {
+            unsigned int vectorColumns = DISPLAY_COLUMNS - (8 - 1 + scale - 1) / scale;
+            for (unsigned int x = 0; x < vectorColumns; ++x) {
+                uint32_t color = (row >> (63u - x)) & 1u ? palette.on : palette.off;
+                __m256i fill = _mm256_set1_epi32(static_cast<int>(color));
+                for (unsigned int i = 0; i < scale; i += 8) {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), fill);
+                }
+                out += scale;
+            }
+            FillColumns(row, vectorColumns, out, scale, palette);
+        }
+
+        ReplicateRow(pixels, pitch, y, scale);
+    }
+}
+
+#endif
+
+char const *ExpandIsaName(ExpandIsa isa) {
+    switch (isa) {
+        case ExpandIsa::Sse2:
+            return "sse2";
+        case ExpandIsa::Avx2:
+            return "avx2";
+        default:
+            return "scalar";
+    }
+}
+
+ExpandIsa SelectExpandIsa(bool hasSse2, bool hasAvx2) {
+#ifdef CHIP8_EXPAND_X86
+    if (hasAvx2) {
+        return ExpandIsa::Avx2;
+    }
+    if (hasSse2) {
+        return ExpandIsa::Sse2;
+    }
+#endif
+    return ExpandIsa::Scalar;
+}
+
+ExpandKernel GetExpandKernel(ExpandIsa isa) {
+    switch (isa) {
+#ifdef CHIP8_EXPAND_X86
+        case ExpandIsa::Sse2:
+            return ExpandSse2;
+        case ExpandIsa::Avx2:
+            return ExpandAvx2;
+#endif
+        default:
+            return ExpandScalar;
+    }
+}
+
+// "RRGGBB:RRGGBB", the on color then the off color
+bool ParsePalette(char const *text, Palette &palette) {
+    unsigned int on, off;
+    char end;
+    if (std::sscanf(text, "%6x:%6x%c", &on, &off, &end) != 2) {
+        return false;
+    }
+    palette.on = (on << 8u) | 0xFFu;
+    palette.off = (off << 8u) | 0xFFu;
+    return true;
+}
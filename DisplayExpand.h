@@ -0,0 +1,41 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_DISPLAYEXPAND_H
+#define CHIP8_INTERPRETER_DISPLAYEXPAND_H
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CHIP8_EXPAND_X86 1
+#endif
+
+// RGBA8888 colors for pixels that are off and on
+struct Palette {
+    uint32_t off;
+    uint32_t on;
+};
+
+static const Palette DEFAULT_PALETTE = {0x00000000, 0xFFFFFFFF};
+
+// Expand a bit-packed display (one word per row, column 0 in the most significant bit) to RGBA8888, every pixel
+// becoming a scale x scale square. pitch is in bytes, like SDL's.
+typedef void (*ExpandKernel)(uint64_t const *display, unsigned int rows, uint32_t *pixels, int pitch,
+                             unsigned int scale, Palette palette);
+
+enum class ExpandIsa {
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+char const *ExpandIsaName(ExpandIsa isa);
+
+// Best kernel for what the CPU supports, falling back to scalar on other architectures
+ExpandIsa SelectExpandIsa(bool hasSse2, bool hasAvx2);
+ExpandKernel GetExpandKernel(ExpandIsa isa);
+
+bool ParsePalette(char const *text, Palette &palette);
+
+#endif //CHIP8_INTERPRETER_DISPLAYEXPAND_H
@@ -0,0 +1,68 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "Footprint.h"
+#include "Chip8.h"
+#include "DecodeCache.h"
+#include "BlockCache.h"
+#include "Jit.h"
+#include "Lockstep.h"
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace std;
+
+static const uint64_t DEFAULT_INSTANCES = 100000;
+static const unsigned int CACHE_LINE = 64;
+
+static size_t OffsetOf(Chip8 const &c, void const *member) {
+    return static_cast<uint8_t const *>(member) - reinterpret_cast<uint8_t const *>(&c);
+}
+
+static void PrintPart(char const *name, size_t begin, size_t end) {
+    std::printf("  %-22s %6zu bytes  offset %4zu, cache lines %zu-%zu\n", name, end - begin, begin,
+                begin / CACHE_LINE, (end - 1) / CACHE_LINE);
+}
+
+int RunFootprintReport(int argc, char *argv[]) {
+    uint64_t instances = DEFAULT_INSTANCES;
+    if (argc > 0 && (!ParseCount(argv[0], instances) || instances == 0)) {
+        std::cerr << "Instances must be a number of at least 1\nUsage: --footprint [Instances]\n";
+        return EXIT_FAILURE;
+    }
+    auto c = make_unique<Chip8>();
+
+    size_t hot = OffsetOf(*c, c->registers);
+    size_t warm = OffsetOf(*c, &c->delay_timer);
+    size_t display = OffsetOf(*c, c->display);
+    size_t memory = OffsetOf(*c, &c->memory);
+    size_t cold = OffsetOf(*c, c->key_read_cycle);
+    size_t rest = OffsetOf(*c, &c->draw_cycle) + sizeof(c->draw_cycle);
+
+    std::printf("Chip8: %zu bytes per instance, %zu-byte aligned\n", sizeof(Chip8), alignof(Chip8));
+    PrintPart("registers, pc, stack", hot, warm);
+    PrintPart("timers, clock, keypad", warm, display);
+    PrintPart("display", display, memory);
+    PrintPart("memory page table", memory, cold);
+    PrintPart("latency tracing", cold, rest);
+    PrintPart("dispatch, rng", rest, sizeof(Chip8));
+
+    // Backends other than switch, table, threaded, tailcall and specialized allocate on first use
+    std::printf("Allocated on first use, per instance:\n");
+    std::printf("  %-22s %6zu bytes\n", "cached", sizeof(DecodeCache));
+    std::printf("  %-22s %6zu bytes + translated blocks\n", "blocks", sizeof(BlockCache));
+    std::printf("  %-22s %6zu bytes + %zu bytes of code buffer\n", "jit", sizeof(Jit), Jit::CODE_BUFFER_SIZE);
+    std::printf("  %-22s %6zu bytes per lane in a LockstepGroup of %u\n", "lockstep",
+                sizeof(LockstepGroup) / LockstepGroup::LANES, LockstepGroup::LANES);
+
+    // Loaded from one image, instances only own the memory pages they have written to
+    std::printf("Memory pages: %u bytes each, shared with the ROM image until written\n", PagedMemory::PAGE_SIZE);
+    std::printf("%llu instances: %.1f MB, plus %.1f MB for every page each of them writes to\n",
+                static_cast<unsigned long long>(instances),
+                static_cast<double>(instances) * sizeof(Chip8) / (1024 * 1024),
+                static_cast<double>(instances) * sizeof(MemoryPage) / (1024 * 1024));
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,12 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_FOOTPRINT_H
+#define CHIP8_INTERPRETER_FOOTPRINT_H
+
+// Print the bytes each Chip8 instance takes, part by part, and what a number of instances add up to.
+// Arguments: [Instances]
+int RunFootprintReport(int argc, char *argv[]);
+
+#endif //CHIP8_INTERPRETER_FOOTPRINT_H
@@ -0,0 +1,88 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "Headless.h"
+#include "Chip8.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+static int Usage(char const *problem) {
+    std::cerr << problem << "\nUsage: --headless --frames|--instructions <Count> <ROM> [CyclesPerFrame] [Dispatch]\n";
+    return EXIT_FAILURE;
+}
+
+int RunHeadless(int argc, char *argv[], uint64_t seed) {
+    if (argc < 3 || (string(argv[0]) != "--frames" && string(argv[0]) != "--instructions")) {
+        return Usage("Expected --frames or --instructions, a count and a ROM");
+    }
+
+    Chip8 chip8;
+    bool countFrames = string(argv[0]) == "--frames";
+    uint64_t count;
+    if (!ParseCount(argv[1], count)) {
+        return Usage("Count must be a non-negative number");
+    }
+    char const *rom_filename = argv[2];
+    unsigned int cyclesPerFrame = chip8.DEFAULT_CYCLES_PER_FRAME;
+
+    if (argc > 3) {
+        uint64_t value;
+        if (!ParseCount(argv[3], value) || value == 0 || value > Chip8::MAX_CYCLES_PER_FRAME) {
+            return Usage("CyclesPerFrame must be between 1 and 1000000");
+        }
+        cyclesPerFrame = value;
+    }
+    // Frames times CyclesPerFrame must still fit the instruction count
+    if (countFrames && count > UINT64_MAX / cyclesPerFrame) {
+        return Usage("Too many frames");
+    }
+    chip8.dispatch_mode = DispatchMode::Specialized;
+    if (argc > 4 && !ParseDispatchMode(argv[4], chip8.dispatch_mode)) {
+        std::cerr << "Unknown dispatch mode: " << argv[4] << "\n";
+        return EXIT_FAILURE;
+    }
+
+    chip8.skip_idle_loops = true;
+    chip8.Seed(seed);
+    if (!chip8.LoadROM(rom_filename)) {
+        std::cerr << "Can't read ROM " << rom_filename << "\n";
+        return EXIT_FAILURE;
+    }
+    chip8.SetClockRate(cyclesPerFrame * chip8.FRAME_RATE);
+
+    // Same frame batching as the windowed loop, minus input, presentation and the frame deadline
+    uint64_t instructions = countFrames ? count * cyclesPerFrame : count;
+    uint64_t frames = 0;
+    uint64_t changedFrames = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t remaining = instructions; remaining > 0; ++frames) {
+        unsigned int batch = remaining < cyclesPerFrame ? remaining : cyclesPerFrame;
+        // Nothing can press a key here, so a key wait never ends: skip the spinning
+        if (chip8.WaitingForKey()) {
+            chip8.AdvanceClock(batch);
+        } else {
+            chip8.Run(batch);
+        }
+        remaining -= batch;
+
+        // Frames a windowed run would have had to present
+        changedFrames += chip8.dirty_rows != 0;
+        chip8.dirty_rows = 0;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::printf("%s: %llu instructions, %llu frames (%llu changed) in %.3f s, %.2f M instructions/s, framebuffer %016llx\n",
+                DispatchModeName(chip8.dispatch_mode), static_cast<unsigned long long>(instructions),
+                static_cast<unsigned long long>(frames),
+                static_cast<unsigned long long>(changedFrames), seconds, seconds > 0 ? instructions / seconds / 1e6 : 0.0,
+                static_cast<unsigned long long>(chip8.FramebufferHash()));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,14 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_HEADLESS_H
+#define CHIP8_INTERPRETER_HEADLESS_H
+
+#include <cstdint>
+
+// Run a ROM without a window as fast as possible, then report instructions per second, frames and a framebuffer hash.
+// Arguments: --frames|--instructions <Count> <ROM> [CyclesPerFrame] [Dispatch]
+int RunHeadless(int argc, char *argv[], uint64_t seed);
+
+#endif //CHIP8_INTERPRETER_HEADLESS_H
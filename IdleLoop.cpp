@@ -0,0 +1,135 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "IdleLoop.h"
+#include <algorithm>
+
+using namespace std;
+
+static const unsigned int MAX_LOOP_INSTRUCTIONS = 16;
+// Instructions run between checks when pc isn't heading into a wait loop
+static const unsigned int IDLE_CHECK_INTERVAL = 1024;
+
+static bool IsTimerRead(uint16_t opcode) {
+    return (opcode & 0xF0FFu) == 0xF007u;
+}
+
+// Follow one instruction that only looks at registers to decide where to go next. False for anything else.
+static bool Branch(uint16_t opcode, uint16_t &address, uint8_t const *registers) {
+    uint8_t x = (opcode & 0x0F00u) >> 8u;
+    uint8_t y = (opcode & 0x00F0u) >> 4u;
+    uint8_t kk = opcode & 0x00FFu;
+
+    switch (opcode >> 12u) {
+        case 0x1:
+            address = opcode & 0x0FFFu;
+            return true;
+        case 0x3:
+            address += registers[x] == kk ? 4 : 2;
+            return true;
+        case 0x4:
+            address += registers[x] != kk ? 4 : 2;
+            return true;
+        case 0x5:
+            address += registers[x] == registers[y] ? 4 : 2;
+            return true;
+        case 0x9:
+            address += registers[x] != registers[y] ? 4 : 2;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Instructions in one pass of the loop starting with the Fx07 at pc when the timer reads value, 0 if that pass
+// leaves the loop or pc doesn't start one
+static unsigned int LoopLength(Chip8 const &c, uint8_t x, uint8_t value) {
+    uint8_t registers[16];
+    std::copy(c.registers, c.registers + 16, registers);
+    registers[x] = value;
+
+    uint16_t address = c.pc + 2;
+    for (unsigned int length = 1; length <= MAX_LOOP_INSTRUCTIONS; ++length) {
+        if (address == c.pc) {
+            return length;
+        }
+        if (!Branch(c.memory.ReadOpcode(address), address, registers)) {
+            return 0;
+        }
+    }
+    return 0;
+}
+
+// Instructions until pc reaches an Fx07 through skips and jumps alone, -1 if it doesn't
+static int StepsToTimerRead(Chip8 const &c) {
+    uint16_t address = c.pc;
+    for (int steps = 0; steps < static_cast<int>(MAX_LOOP_INSTRUCTIONS); ++steps) {
+        uint16_t opcode = c.memory.ReadOpcode(address);
+        if (IsTimerRead(opcode)) {
+            return steps;
+        }
+        if (!Branch(opcode, address, c.registers)) {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+uint64_t SkipIdleLoop(Chip8 &c, uint64_t maxCycles) {
+    uint64_t skipped = 0;
+
+    for (;;) {
+        uint16_t opcode = c.memory.ReadOpcode(c.pc);
+        if (!IsTimerRead(opcode)) {
+            return skipped;
+        }
+
+        uint8_t x = (opcode & 0x0F00u) >> 8u;
+        uint8_t value = c.GetDelayTimer();
+        unsigned int length = LoopLength(c, x, value);
+        if (!length) {
+            return skipped;
+        }
+
+        // The timer only counts down, so find the lowest value every pass down to still loops the same way
+        uint8_t lowest = value;
+        while (lowest > 0 && LoopLength(c, x, lowest - 1) == length) {
+            --lowest;
+        }
+
+        // Passes until the timer reads lowest - 1; if the loop holds all the way down to 0 it never ends
+        uint64_t passes = (maxCycles - skipped) / length;
+        if (lowest > 0) {
+            uint64_t exitTick = c.delay_timer_tick + (c.delay_timer - (lowest - 1));
+            uint64_t exitCycle = c.CycleAtTick(exitTick);
+            passes = std::min(passes, (exitCycle - c.cycle_count + length - 1) / length);
+        }
+
+        if (!passes) {
+            return skipped;
+        }
+
+        uint64_t lastRead = c.cycle_count + (passes - 1) * length;
+        c.registers[x] = c.DelayTimerAt(c.TickAt(lastRead));
+        c.cycle_count += passes * length;
+        skipped += passes * length;
+    }
+}
+
+void RunSkippingIdleLoops(Chip8 &c, unsigned int cycles) {
+    unsigned int remaining = cycles;
+
+    while (remaining > 0) {
+        remaining -= SkipIdleLoop(c, remaining);
+        if (!remaining) {
+            break;
+        }
+
+        // Partway through what may be a wait loop, run up to its Fx07 so the next check can see it
+        int steps = StepsToTimerRead(c);
+        unsigned int slice = std::min(steps > 0 ? static_cast<unsigned int>(steps) : IDLE_CHECK_INTERVAL, remaining);
+        c.RunDispatch(slice);
+        remaining -= slice;
+    }
+}
@@ -0,0 +1,22 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_IDLELOOP_H
+#define CHIP8_INTERPRETER_IDLELOOP_H
+
+#include "Chip8.h"
+
+// Delay-timer wait loops: Fx07 into Vx, then only skips and jumps (3xkk, 4xkk, 5xy0, 9xy0, 1nnn) back to the Fx07.
+// Every pass leaves the machine as it found it except for Vx and the clock, so passes that read the same timer
+// value can be skipped in one step.
+
+// Skip whole passes of the wait loop at pc, at most maxCycles instructions' worth, up to the pass that reads the
+// value that leaves the loop. Returns the number of instructions skipped.
+uint64_t SkipIdleLoop(Chip8 &c, uint64_t maxCycles);
+
+// Run cycles instructions with the selected backend, skipping wait loops. Ends in exactly the state that running
+// every instruction would.
+void RunSkippingIdleLoops(Chip8 &c, unsigned int cycles);
+
+#endif //CHIP8_INTERPRETER_IDLELOOP_H
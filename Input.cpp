@@ -0,0 +1,44 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "Input.h"
+#include "LatencyTracker.h"
+
+using namespace std;
+
+void RunFrameWithInput(Chip8 &c, unsigned int cycles, KeyEventQueue &queue, chrono::steady_clock::time_point start,
+                       chrono::steady_clock::duration duration, LatencyTracker *tracker) {
+    unsigned int done = 0;
+    KeyEvent event;
+
+    while (queue.Peek(event)) {
+        if (event.time >= start + duration) {
+            break;
+        }
+
+        // Cycle within the frame matching the event's share of the frame's host time
+        unsigned int at = 0;
+        if (event.time > start) {
+            at = static_cast<unsigned int>((event.time - start).count() * static_cast<double>(cycles) /
+                                           duration.count());
+        }
+        if (at > done) {
+            c.Run(at - done);
+            done = at;
+        }
+
+        uint16_t bit = 1u << (event.key & 0xFu);
+        if (event.pressed) {
+            c.keypad.fetch_or(bit, memory_order_relaxed);
+        } else {
+            c.keypad.fetch_and(~bit, memory_order_relaxed);
+        }
+        if (tracker) {
+            tracker->KeyApplied(c, event);
+        }
+        queue.Pop();
+    }
+
+    c.Run(cycles - done);
+}
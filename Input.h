@@ -0,0 +1,30 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_INPUT_H
+#define CHIP8_INTERPRETER_INPUT_H
+
+#include "Chip8.h"
+#include "SpscQueue.h"
+#include <chrono>
+
+// A key going down or up, stamped with the host time it was seen at
+struct KeyEvent {
+    chrono::steady_clock::time_point time;
+    uint8_t key;
+    bool pressed;
+};
+
+// Filled by the thread polling input, drained by the emulation thread
+typedef SpscQueue<KeyEvent, 1024> KeyEventQueue;
+
+class LatencyTracker;
+
+// Run one frame of cycles that stands for host time [start, start + duration), applying each queued key event at the
+// cycle its timestamp falls on. Events from before the frame are applied at its first cycle; events from after it
+// stay queued for the next one. Applied events are reported to tracker when there is one.
+void RunFrameWithInput(Chip8 &c, unsigned int cycles, KeyEventQueue &queue, chrono::steady_clock::time_point start,
+                       chrono::steady_clock::duration duration, LatencyTracker *tracker = nullptr);
+
+#endif //CHIP8_INTERPRETER_INPUT_H
@@ -0,0 +1,331 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_INSTRUCTIONS_H
+#define CHIP8_INTERPRETER_INSTRUCTIONS_H
+
+#include "Chip8.h"
+#include <algorithm>
+
+// Instruction semantics with their operands already decoded.
+// Every dispatch backend goes through these, so they all execute the exact same instruction set.
+namespace Instructions {
+
+    inline uint8_t Vx(uint16_t opcode) { return (opcode & 0x0F00u) >> 8u; }
+    inline uint8_t Vy(uint16_t opcode) { return (opcode & 0x00F0u) >> 4u; }
+    inline uint8_t kk(uint16_t opcode) { return opcode & 0x00FFu; }
+    inline uint8_t n(uint16_t opcode) { return opcode & 0x000Fu; }
+    inline uint16_t nnn(uint16_t opcode) { return opcode & 0x0FFFu; }
+
+    inline bool KeyPressed(Chip8 &c, uint8_t key) {
+        if (c.trace_latency) {
+            c.key_read_cycle[key & 0xFu] = std::min(c.key_read_cycle[key & 0xFu], c.cycle_count);
+        }
+        return (c.keypad.load(std::memory_order_relaxed) >> (key & 0xFu)) & 1u;
+    }
+
+    // Fetch the next instruction and advance pc
+    inline uint16_t Fetch(Chip8 &c) {
+        uint16_t opcode = c.memory.ReadOpcode(c.pc);
+        c.pc += 2;
+        return opcode;
+    }
+
+    // CLS
+    // CLear the display
+    inline void OP_00E0(Chip8 &c) {
+        if (c.trace_latency) {
+            c.draw_cycle = c.cycle_count;
+        }
+        for (unsigned int row = 0; row < c.VIDEO_HEIGHT; ++row) {
+            if (c.display[row]) {
+                c.dirty_rows |= 1u << row;
+            }
+        }
+        std::memset(c.display, 0, sizeof(c.display));
+    }
+
+    // RET
+    // Return from the subroutine
+    inline void OP_00EE(Chip8 &c) {
+        --c.sp;
+        c.pc = c.stack[c.sp & 0xFu];
+    }
+
+    // JP addr
+    // Jump to location nnn
+    inline void OP_1nnn(Chip8 &c, uint16_t address) {
+        c.pc = address;
+    }
+
+    // CALL addr
+    // Call subroutine at nnn
+    inline void OP_2nnn(Chip8 &c, uint16_t address) {
+        c.stack[c.sp & 0xFu] = c.pc;
+        ++c.sp;
+        c.pc = address;
+    }
+
+    // SE Vx, byte
+    // Skip next instruction if Vx = kk
+    inline void OP_3xkk(Chip8 &c, uint8_t x, uint8_t value) {
+        if (c.registers[x] == value) {
+            c.pc += 2;
+        }
+    }
+
+    // SNE Vx, byte
+    // Skip next instruction if Vx != kk
+    inline void OP_4xkk(Chip8 &c, uint8_t x, uint8_t value) {
+        if (c.registers[x] != value) {
+            c.pc += 2;
+        }
+    }
+
+    // SE Vx, Vy
+    // Skip next instruction if Vx = Vy
+    inline void OP_5xy0(Chip8 &c, uint8_t x, uint8_t y) {
+        if (c.registers[x] == c.registers[y]) {
+            c.pc += 2;
+        }
+    }
+
+    // LD Vx, byte
+    // Set Vx = kk
+    inline void OP_6xkk(Chip8 &c, uint8_t x, uint8_t value) {
+        c.registers[x] = value;
+    }
+
+    // ADD Vx, byte
+    // Set Vx = Vx + kk
+    inline void OP_7xkk(Chip8 &c, uint8_t x, uint8_t value) {
+        c.registers[x] += value;
+    }
+
+    // LD Vx, Vy
+    // Set Vx = Vy
+    inline void OP_8xy0(Chip8 &c, uint8_t x, uint8_t y) {
+        c.registers[x] = c.registers[y];
+    }
+
+    // OR Vx, Vy
+    // Set Vx = Vx OR Vy
+    inline void OP_8xy1(Chip8 &c, uint8_t x, uint8_t y) {
+        c.registers[x] |= c.registers[y];
+    }
+
+    // AND Vx, Vy
+    // Set Vx = Vx AND Vy
+    inline void OP_8xy2(Chip8 &c, uint8_t x, uint8_t y) {
+        c.registers[x] &= c.registers[y];
+    }
+
+    // XOR Vx, Vy
+    // Set Vx = Vx XOR Vy
+    inline void OP_8xy3(Chip8 &c, uint8_t x, uint8_t y) {
+        c.registers[x] ^= c.registers[y];
+    }
+
+    // ADD Vx, Vy
+    // Set Vx = Vx + Vy, set VF = carry
+    inline void OP_8xy4(Chip8 &c, uint8_t x, uint8_t y) {
+        uint16_t sum = c.registers[x] + c.registers[y];
+
+        if (sum > 255u) {
+            c.registers[0xF] = 1;
+        } else {
+            c.registers[0xF] = 0;
+        }
+
+        c.registers[x] = sum & 0xFFu;
+    }
+
+    // SUB Vx, Vy
+    // Set Vx = Vx - Vy, set VF = NOT borrow
+    inline void OP_8xy5(Chip8 &c, uint8_t x, uint8_t y) {
+        uint16_t sub = c.registers[x] - c.registers[y];
+
+        if (sub > 0) {
+            c.registers[0xF] = 1;
+        } else {
+            c.registers[0xF] = 0;
+        }
+
+        c.registers[x] = sub & 0xFFu;
+    }
+
+    // SHR Vx
+    // Set Vx = Vx SHR 1
+    inline void OP_8xy6(Chip8 &c, uint8_t x) {
+        c.registers[0xF] = (c.registers[x] & 0x1u);
+        c.registers[x] >>= 1;
+    }
+
+    // SUBN Vx, Vy
+    // Set Vx = Vy - Vx, set VF = NOT borrow
+    inline void OP_8xy7(Chip8 &c, uint8_t x, uint8_t y) {
+        uint16_t sub = c.registers[x] - c.registers[y];
+
+        if (sub <= 0) {
+            c.registers[0xF] = 1;
+        } else {
+            c.registers[0xF] = 0;
+        }
+
+        c.registers[x] = sub & 0xFFu;
+    }
+
+    // SHL Vx {, Vy}
+    // Set Vx = Vx SHL 1
+    inline void OP_8xyE(Chip8 &c, uint8_t x) {
+        c.registers[0xF] = (c.registers[x] & 0x80u) >> 7u;
+        c.registers[x] <<= 1;
+    }
+
+    // SNE Vx, Vy
+    // Skip next instruction if Vx != Vy
+    inline void OP_9xy0(Chip8 &c, uint8_t x, uint8_t y) {
+        if (c.registers[x] != c.registers[y]) {
+            c.pc += 2;
+        }
+    }
+
+    // LD I, addr
+    // Set I = nnn
+    inline void OP_Annn(Chip8 &c, uint16_t address) {
+        c.index = address;
+    }
+
+    // JP V0, addr
+    // Jump to location nnn + V0
+    inline void OP_Bnnn(Chip8 &c, uint16_t address) {
+        c.pc = address + c.registers[0];
+    }
+
+    // RND Vx, byte
+    // Set Vx = random byte AND kk
+    inline void OP_Cxkk(Chip8 &c, uint8_t x, uint8_t value) {
+        c.registers[x] = value & c.getRandomByte();
+    }
+
+    // DRW Vx, Vy, nibble
+    // Display n-byte sprite starting at memory location I at (Vx, Vy), set VF = collision
+    inline void OP_Dxyn(Chip8 &c, uint8_t x, uint8_t y, uint8_t height) {
+        // Wrap if going beyond screen boundaries
+        uint8_t xPos = c.registers[x] % c.VIDEO_WIDTH;
+        uint8_t yPos = c.registers[y] % c.VIDEO_HEIGHT;
+
+        uint64_t collision = 0;
+        if (c.trace_latency) {
+            c.draw_cycle = c.cycle_count;
+        }
+
+        // Sprites are clipped at the right and bottom edges: bits shifted past column 63 fall off the row
+        for (unsigned int row = 0; row < height && yPos + row < c.VIDEO_HEIGHT; ++row) {
+            uint64_t spriteRow = (uint64_t(c.memory.Read(c.index + row)) << 56u) >> xPos;
+            uint64_t &screenRow = c.display[yPos + row];
+
+            collision |= screenRow & spriteRow;
+            screenRow ^= spriteRow;
+            c.dirty_rows |= 1u << (yPos + row);
+        }
+
+        c.registers[0xF] = collision != 0;
+    }
+
+    // SKP Vx
+    // Skip next instruction if key with the value of Vx is pressed
+    inline void OP_Ex9E(Chip8 &c, uint8_t x) {
+        if (KeyPressed(c, c.registers[x])) {
+            c.pc += 2;
+        }
+    }
+
+    // SKNP Vx
+    // Skip next instruction if key with the value of Vx is not pressed
+    inline void OP_ExA1(Chip8 &c, uint8_t x) {
+        if (!KeyPressed(c, c.registers[x])) {
+            c.pc += 2;
+        }
+    }
+
+    // LD Vx, DT
+    // Set Vx = delay timer value
+    inline void OP_Fx07(Chip8 &c, uint8_t x) {
+        c.registers[x] = c.GetDelayTimer();
+    }
+
+    // LD Vx, K
+    // Wait for a key press, store the value of the key in Vx
+    inline void OP_Fx0A(Chip8 &c, uint8_t x) {
+        for (uint8_t i = 0; i < 16; i++) {
+            if (KeyPressed(c, i)) {
+                c.registers[x] = i;
+                return;
+            }
+        }
+        c.pc -= 2;
+    }
+
+    // LD DT, Vx
+    // Set delay timer = Vx
+    inline void OP_Fx15(Chip8 &c, uint8_t x) {
+        c.SetDelayTimer(c.registers[x]);
+    }
+
+    // LD ST, Vx
+    // Set sound timer = Vx
+    inline void OP_Fx18(Chip8 &c, uint8_t x) {
+        c.SetSoundTimer(c.registers[x]);
+    }
+
+    // ADD I, Vx
+    // Set I = I + Vx
+    inline void OP_Fx1E(Chip8 &c, uint8_t x) {
+        c.index += c.registers[x];
+    }
+
+    // LD F, Vx
+    // Set I = location of sprite for digit Vx
+    inline void OP_Fx29(Chip8 &c, uint8_t x) {
+        c.index = c.memory.Read(c.FONTSET_START_ADDRESS + (c.registers[x] * 5));
+    }
+
+    // LD B, Vx
+    // Store BCD representation of Vx in memory locations I, I+1, and I+2
+    inline void OP_Fx33(Chip8 &c, uint8_t x) {
+        uint8_t value = c.registers[x];
+
+        c.memory.Write(c.index + 2, value % 10);
+        value /= 10;
+
+        c.memory.Write(c.index + 1, value % 10);
+        value /= 10;
+
+        c.memory.Write(c.index, value % 10);
+
+        c.MemoryWritten(c.index & 0x0FFFu, 3);
+    }
+
+    // LD [I], Vx
+    // Store registers V0 through Vx in memory starting at location I.
+    inline void OP_Fx55(Chip8 &c, uint8_t x) {
+        for (uint8_t i = 0; i <= x; i++) {
+            c.memory.Write(c.index + i, c.registers[i]);
+        }
+
+        c.MemoryWritten(c.index & 0x0FFFu, x + 1);
+    }
+
+    // LD Vx, [I]
+    // Read registers V0 through Vx from memory starting at location I
+    inline void OP_Fx65(Chip8 &c, uint8_t x) {
+        for (uint8_t i = 0; i <= x; i++) {
+            c.registers[i] = c.memory.Read(c.index + i);
+        }
+    }
+
+}
+
+#endif //CHIP8_INTERPRETER_INSTRUCTIONS_H
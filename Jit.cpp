@@ -0,0 +1,675 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "Jit.h"
+
+#ifdef CHIP8_JIT_SUPPORTED
+
+#include <algorithm>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// x86-64 register numbers used in ModRM encodings
+enum : uint8_t {
+    EAX = 0,
+    ECX = 1,
+    EDX = 2,
+    RBP = 5,
+    RSI = 6,
+    RDI = 7,
+    R8 = 8,
+    R9 = 9,
+    R10 = 10,
+    R11 = 11,
+    R12 = 12,
+    R13 = 13,
+    R14 = 14,
+    R15 = 15,
+};
+
+// A guest register as an r/m operand: a host register, or its slot at [rbx + disp32]
+struct Operand {
+    int8_t host;
+    int32_t disp;
+};
+
+// Minimal x86-64 encoder. Guest state is addressed as [rbx + disp32], with rbx holding the Chip8 pointer.
+class Emitter {
+public:
+    explicit Emitter(uint8_t *out) : out(out) {}
+
+    void Byte(uint8_t value) { out[size++] = value; }
+
+    void Bytes(std::initializer_list<uint8_t> values) {
+        for (uint8_t value: values) {
+            Byte(value);
+        }
+    }
+
+    void Imm16(uint16_t value) {
+        std::memcpy(out + size, &value, sizeof(value));
+        size += sizeof(value);
+    }
+
+    void Imm32(uint32_t value) {
+        std::memcpy(out + size, &value, sizeof(value));
+        size += sizeof(value);
+    }
+
+    void Imm64(uint64_t value) {
+        std::memcpy(out + size, &value, sizeof(value));
+        size += sizeof(value);
+    }
+
+    // <opcode> reg, [rbx + disp32]
+    void Mem(std::initializer_list<uint8_t> opcode, uint8_t reg, int32_t disp) {
+        Bytes(opcode);
+        Byte(0x80u | (reg << 3u) | 0x3u);
+        Imm32(disp);
+    }
+
+    // <opcode> reg, r/m, with a 0x66 prefix for 16-bit operands. The REX prefix is always there so that byte
+    // operands of rsi, rdi, rbp and r8-r15 mean their low bytes.
+    void Op(std::initializer_list<uint8_t> opcode, uint8_t reg, Operand rm, bool word = false) {
+        if (word) {
+            Byte(0x66);
+        }
+        uint8_t host = rm.host < 0 ? 0 : rm.host;
+        Byte(0x40u | ((reg & 8u) >> 1u) | ((host & 8u) >> 3u));
+        Bytes(opcode);
+        if (rm.host < 0) {
+            Byte(0x80u | ((reg & 7u) << 3u) | 0x3u);
+            Imm32(rm.disp);
+        } else {
+            Byte(0xC0u | ((reg & 7u) << 3u) | (host & 7u));
+        }
+    }
+
+    void Push(uint8_t reg) {
+        if (reg & 8u) {
+            Byte(0x41);
+        }
+        Byte(0x50u | (reg & 7u));
+    }
+
+    void Pop(uint8_t reg) {
+        if (reg & 8u) {
+            Byte(0x41);
+        }
+        Byte(0x58u | (reg & 7u));
+    }
+
+    // Conditional short jump with the target patched in later by Bind()
+    size_t Jcc(uint8_t opcode) {
+        Bytes({opcode, 0x00});
+        return size - 1;
+    }
+
+    void Bind(size_t jump) {
+        out[jump] = static_cast<uint8_t>(size - (jump + 1));
+    }
+
+    uint8_t *out;
+    size_t size{};
+};
+
+// Instructions the JIT does not compile run through the interpreter
+static void JitInterpret(Chip8 *c, uint32_t opcode) {
+    c->opcode = opcode;
+    c->opcode_translation(opcode);
+}
+
+enum class JitKind {
+    Native,     // Compiled inline, falls through to the next instruction
+    Branch,     // Compiled inline, ends the block and sets pc itself
+    Helper,     // Calls back into the interpreter
+    HelperEnd   // Calls back into the interpreter and ends the block
+};
+
+static JitKind Classify(uint16_t opcode) {
+    switch (opcode >> 12u) {
+        case 0x0:
+            switch (opcode & 0x000Fu) {
+                case 0x0: return JitKind::Helper;
+                case 0xE: return JitKind::Branch;
+                default: return JitKind::Native;
+            }
+        case 0x1:
+        case 0x2:
+        case 0x3:
+        case 0x4:
+        case 0x5:
+        case 0x9:
+        case 0xB:
+            return JitKind::Branch;
+        case 0xC:
+        case 0xD:
+            return JitKind::Helper;
+        case 0xE:
+            switch (opcode & 0x000Fu) {
+                case 0x1:
+                case 0xE:
+                    return JitKind::HelperEnd;
+                default:
+                    return JitKind::Native;
+            }
+        case 0xF:
+            switch (opcode & 0x00FFu) {
+                case 0x1E:
+                    return JitKind::Native;
+                case 0x07:
+                case 0x15:
+                case 0x18:
+                case 0x29:
+                case 0x65:
+                    return JitKind::Helper;
+                case 0x0A:
+                case 0x33:
+                case 0x55:
+                    return JitKind::HelperEnd;
+                default:
+                    return JitKind::Native;
+            }
+        default:
+            return JitKind::Native;
+    }
+}
+
+// Guest registers used more than once in a block live in these host registers while it runs, caller-saved first.
+// Vx are kept as their low byte, I as its low word.
+static const uint8_t GUEST_HOSTS[] = {R8, R9, R10, R11, RSI, RDI, RBP, R12, R13, R14, R15};
+static const unsigned int GUEST_INDEX = 16;
+
+static bool CalleeSaved(uint8_t reg) {
+    return reg == RBP || reg >= R12;
+}
+
+// The code buffer is never writable and executable at once: it is mapped RW, and the pages of each block are
+// switched to RX once it is emitted and back to RW while the next block is emitted next to them
+static bool Protect(uint8_t *buffer, size_t from, size_t length, int protection) {
+    static const size_t pageSize = sysconf(_SC_PAGESIZE);
+    size_t first = from / pageSize * pageSize;
+    size_t last = from + length < Jit::CODE_BUFFER_SIZE ? from + length : Jit::CODE_BUFFER_SIZE;
+    return mprotect(buffer + first, last - first, protection) == 0;
+}
+
+Jit::Jit() {
+    void *buffer = mmap(nullptr, CODE_BUFFER_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffer != MAP_FAILED) {
+        code_buffer = static_cast<uint8_t *>(buffer);
+    }
+}
+
+Jit::~Jit() {
+    if (code_buffer) {
+        munmap(code_buffer, CODE_BUFFER_SIZE);
+    }
+}
+
+void Jit::Flush() {
+    std::memset(blocks, 0, sizeof(blocks));
+    std::memset(coverage, 0, sizeof(coverage));
+    code_used = 0;
+    ++flushes;
+}
+
+// Drops every block and the buffer, leaving everything to the interpreter
+void Jit::Release() {
+    Flush();
+    munmap(code_buffer, CODE_BUFFER_SIZE);
+    code_buffer = nullptr;
+}
+
+void Jit::Compile(Chip8 &c, uint16_t start) {
+    // Worst case is a helper call per instruction with every cached register spilled before it, about 130 bytes
+    const size_t maxBlockCode = MAX_BLOCK_INSTRUCTIONS * 160 + 128;
+    if (CODE_BUFFER_SIZE - code_used < maxBlockCode) {
+        Flush();
+    }
+    if (!Protect(code_buffer, code_used, maxBlockCode, PROT_READ | PROT_WRITE)) {
+        Release();
+        return;
+    }
+
+    auto base = reinterpret_cast<uint8_t *>(&c);
+    auto offset = [base](void const *field) {
+        return static_cast<int32_t>(static_cast<uint8_t const *>(field) - base);
+    };
+    const int32_t REGISTERS = offset(c.registers);
+    const int32_t PC = offset(&c.pc);
+    const int32_t INDEX = offset(&c.index);
+    const int32_t SP = offset(&c.sp);
+    const int32_t STACK = offset(c.stack);
+    const int32_t CYCLES = offset(&c.cycle_count);
+
+    // Find the end of the block first, to know which guest registers it uses most
+    uint16_t opcodes[MAX_BLOCK_INSTRUCTIONS];
+    uint16_t address = start;
+    uint16_t count = 0;
+    unsigned int uses[17]{};
+    for (bool ended = false; !ended;) {
+        uint16_t opcode = c.memory.ReadOpcode(address);
+        opcodes[count++] = opcode;
+        address += 2;
+
+        uint8_t x = (opcode & 0x0F00u) >> 8u;
+        uint8_t y = (opcode & 0x00F0u) >> 4u;
+        JitKind kind = Classify(opcode);
+        if (kind == JitKind::Native || kind == JitKind::Branch) {
+            switch (opcode >> 12u) {
+                case 0x3:
+                case 0x4:
+                case 0x6:
+                case 0x7:
+                    ++uses[x];
+                    break;
+                case 0x5:
+                case 0x9:
+                    ++uses[x];
+                    ++uses[y];
+                    break;
+                case 0x8:
+                    ++uses[x];
+                    ++uses[y];
+                    ++uses[0xF];
+                    break;
+                case 0xA:
+                    ++uses[GUEST_INDEX];
+                    break;
+                case 0xB:
+                    ++uses[0x0];
+                    break;
+                case 0xF:
+                    ++uses[x];
+                    ++uses[GUEST_INDEX];
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // Blocks never wrap around the end of memory
+        ended = kind == JitKind::Branch || kind == JitKind::HelperEnd || count == MAX_BLOCK_INSTRUCTIONS ||
+                address >= PagedMemory::SIZE;
+    }
+
+    struct Cached {
+        int8_t host = -1;
+        bool loaded = false;    // the host register holds the guest value
+        bool dirty = false;     // and it hasn't been stored back yet
+    };
+    Cached cached[17];
+    uint8_t order[17];
+    for (uint8_t r = 0; r < 17; ++r) {
+        order[r] = r;
+    }
+    std::stable_sort(order, order + 17, [&uses](uint8_t a, uint8_t b) { return uses[a] > uses[b]; });
+    uint8_t saved[sizeof(GUEST_HOSTS)];
+    unsigned int savedCount = 0;
+    for (unsigned int i = 0; i < sizeof(GUEST_HOSTS) && uses[order[i]] > 1; ++i) {
+        cached[order[i]].host = GUEST_HOSTS[i];
+        if (CalleeSaved(GUEST_HOSTS[i])) {
+            saved[savedCount++] = GUEST_HOSTS[i];
+        }
+    }
+
+    Emitter e(code_buffer + code_used);
+
+    auto memory = [&](unsigned int r) {
+        return Operand{-1, r == GUEST_INDEX ? INDEX : REGISTERS + static_cast<int32_t>(r)};
+    };
+    auto load = [&](unsigned int r) {
+        if (r == GUEST_INDEX) {
+            e.Op({0x0F, 0xB7}, cached[r].host, memory(r));     // movzx host, word [index]
+        } else {
+            e.Op({0x0F, 0xB6}, cached[r].host, memory(r));     // movzx host, byte [Vr]
+        }
+    };
+    auto store = [&](unsigned int r) {
+        if (r == GUEST_INDEX) {
+            e.Op({0x89}, cached[r].host, memory(r), true);     // mov [index], host16
+        } else {
+            e.Op({0x88}, cached[r].host, memory(r));           // mov [Vr], host8
+        }
+    };
+    // Where guest register r is read from
+    auto in = [&](unsigned int r) {
+        Cached &reg = cached[r];
+        if (reg.host < 0) {
+            return memory(r);
+        }
+        if (!reg.loaded) {
+            load(r);
+            reg.loaded = true;
+        }
+        return Operand{reg.host, 0};
+    };
+    // Where guest register r is written to, all of it
+    auto out = [&](unsigned int r) {
+        Cached &reg = cached[r];
+        if (reg.host < 0) {
+            return memory(r);
+        }
+        reg.loaded = true;
+        reg.dirty = true;
+        return Operand{reg.host, 0};
+    };
+    // Read, then written in place
+    auto inOut = [&](unsigned int r) {
+        Operand operand = in(r);
+        cached[r].dirty = cached[r].host >= 0;
+        return operand;
+    };
+    // Stores what has changed, and forgets all cached values when the interpreter is about to run
+    auto spill = [&](bool forget) {
+        for (unsigned int r = 0; r < 17; ++r) {
+            if (cached[r].dirty) {
+                store(r);
+                cached[r].dirty = false;
+            }
+            if (forget) {
+                cached[r].loaded = false;
+            }
+        }
+    };
+
+    // pc and cycle_count are only written back when something needs them
+    uint16_t pendingPc = 0;
+    uint32_t pendingCycles = 0;
+    auto flushPc = [&]() {
+        if (pendingPc) {
+            e.Mem({0x66, 0x81}, 0, PC);         // add word [pc], imm16
+            e.Imm16(pendingPc);
+            pendingPc = 0;
+        }
+    };
+    auto flushCycles = [&]() {
+        if (pendingCycles) {
+            e.Mem({0x48, 0x81}, 0, CYCLES);     // add qword [cycle_count], imm32
+            e.Imm32(pendingCycles);
+            pendingCycles = 0;
+        }
+    };
+
+    // Keep rsp 16-byte aligned for the helper calls
+    bool pad = savedCount % 2 != 0;
+    e.Byte(0x53);                               // push rbx
+    for (unsigned int i = 0; i < savedCount; ++i) {
+        e.Push(saved[i]);
+    }
+    if (pad) {
+        e.Bytes({0x48, 0x83, 0xEC, 0x08});      // sub rsp, 8
+    }
+    e.Bytes({0x48, 0x89, 0xFB});                // mov rbx, rdi
+
+    for (uint16_t i = 0; i < count; ++i) {
+        uint16_t opcode = opcodes[i];
+        pendingPc += 2;
+
+        uint8_t x = (opcode & 0x0F00u) >> 8u;
+        uint8_t y = (opcode & 0x00F0u) >> 4u;
+        uint8_t kk = opcode & 0x00FFu;
+        uint16_t nnn = opcode & 0x0FFFu;
+        JitKind kind = Classify(opcode);
+
+        if (kind == JitKind::Helper || kind == JitKind::HelperEnd) {
+            flushPc();
+            flushCycles();
+            spill(true);
+            e.Bytes({0x48, 0x89, 0xDF});        // mov rdi, rbx
+            e.Byte(0xBE);                       // mov esi, opcode
+            e.Imm32(opcode);
+            e.Bytes({0x48, 0xB8});              // mov rax, JitInterpret
+            e.Imm64(reinterpret_cast<uint64_t>(&JitInterpret));
+            e.Bytes({0xFF, 0xD0});              // call rax
+        } else {
+            switch (opcode >> 12u) {
+                case 0x0:
+                    if ((opcode & 0x000Fu) == 0xE) {
+                        e.Mem({0x0F, 0xB6}, EAX, SP);       // movzx eax, byte [sp]
+                        e.Bytes({0xFF, 0xC8});              // dec eax
+                        e.Mem({0x88}, EAX, SP);             // mov [sp], al
+                        e.Bytes({0x83, 0xE0, 0x0F});        // and eax, 0xF
+                        e.Bytes({0x0F, 0xB7, 0x8C, 0x43});  // movzx ecx, word [rbx + rax*2 + stack]
+                        e.Imm32(STACK);
+                        e.Mem({0x66, 0x89}, ECX, PC);       // mov [pc], cx
+                        pendingPc = 0;
+                    }
+                    break;
+                case 0x1:
+                    e.Mem({0x66, 0xC7}, 0, PC);             // mov word [pc], nnn
+                    e.Imm16(nnn);
+                    pendingPc = 0;
+                    break;
+                case 0x2:
+                    e.Mem({0x0F, 0xB7}, EAX, PC);           // movzx eax, word [pc]
+                    e.Byte(0x05);                           // add eax, pendingPc
+                    e.Imm32(pendingPc);
+                    e.Mem({0x0F, 0xB6}, ECX, SP);           // movzx ecx, byte [sp]
+                    e.Bytes({0x89, 0xCA});                  // mov edx, ecx
+                    e.Bytes({0x83, 0xE1, 0x0F});            // and ecx, 0xF
+                    e.Bytes({0x66, 0x89, 0x84, 0x4B});      // mov [rbx + rcx*2 + stack], ax
+                    e.Imm32(STACK);
+                    e.Bytes({0xFF, 0xC2});                  // inc edx
+                    e.Mem({0x88}, EDX, SP);                 // mov [sp], dl
+                    e.Mem({0x66, 0xC7}, 0, PC);             // mov word [pc], nnn
+                    e.Imm16(nnn);
+                    pendingPc = 0;
+                    break;
+                case 0x3:
+                case 0x4:
+                case 0x5:
+                case 0x9: {
+                    flushPc();
+                    if ((opcode >> 12u) == 0x3 || (opcode >> 12u) == 0x4) {
+                        e.Op({0x80}, 7, in(x));             // cmp Vx, kk
+                        e.Byte(kk);
+                    } else {
+                        Operand vy = in(y);
+                        e.Op({0x8A}, EAX, in(x));           // mov al, Vx
+                        e.Op({0x3A}, EAX, vy);              // cmp al, Vy
+                    }
+                    bool skipIfEqual = (opcode >> 12u) == 0x3 || (opcode >> 12u) == 0x5;
+                    size_t noSkip = e.Jcc(skipIfEqual ? 0x75 : 0x74); // jne / je
+                    e.Mem({0x66, 0x81}, 0, PC);             // add word [pc], 2
+                    e.Imm16(2);
+                    e.Bind(noSkip);
+                    break;
+                }
+                case 0x6:
+                    e.Op({0xC6}, 0, out(x));                // mov Vx, kk
+                    e.Byte(kk);
+                    break;
+                case 0x7:
+                    e.Op({0x80}, 0, inOut(x));              // add Vx, kk
+                    e.Byte(kk);
+                    break;
+                case 0x8:
+                    switch (opcode & 0x000Fu) {
+                        case 0x0:
+                            e.Op({0x8A}, EAX, in(y));       // mov al, Vy
+                            e.Op({0x88}, EAX, out(x));      // mov Vx, al
+                            break;
+                        case 0x1:
+                            e.Op({0x8A}, EAX, in(y));       // mov al, Vy
+                            e.Op({0x08}, EAX, inOut(x));    // or Vx, al
+                            break;
+                        case 0x2:
+                            e.Op({0x8A}, EAX, in(y));       // mov al, Vy
+                            e.Op({0x20}, EAX, inOut(x));    // and Vx, al
+                            break;
+                        case 0x3:
+                            e.Op({0x8A}, EAX, in(y));       // mov al, Vy
+                            e.Op({0x30}, EAX, inOut(x));    // xor Vx, al
+                            break;
+                        case 0x4:
+                        case 0x5:
+                        case 0x7:
+                            e.Op({0x0F, 0xB6}, EAX, in(x));         // movzx eax, Vx
+                            e.Op({0x0F, 0xB6}, ECX, in(y));         // movzx ecx, Vy
+                            if ((opcode & 0x000Fu) == 0x4) {
+                                e.Bytes({0x01, 0xC8});              // add eax, ecx
+                                e.Byte(0x3D);                       // cmp eax, 255
+                                e.Imm32(255);
+                                e.Bytes({0x0F, 0x97, 0xC2});        // seta dl
+                            } else {
+                                e.Bytes({0x39, 0xC8});              // cmp eax, ecx
+                                // 8xy5 sets VF when Vx != Vy, 8xy7 when they are equal
+                                e.Bytes({0x0F, static_cast<uint8_t>((opcode & 0x000Fu) == 0x5 ? 0x95 : 0x94),
+                                         0xC2});                    // setne / sete dl
+                                e.Bytes({0x29, 0xC8});              // sub eax, ecx
+                            }
+                            e.Op({0x88}, EDX, out(0xF));            // mov VF, dl
+                            e.Op({0x88}, EAX, out(x));              // mov Vx, al
+                            break;
+                        case 0x6:
+                        case 0xE:
+                            e.Op({0x0F, 0xB6}, EAX, in(x));         // movzx eax, Vx
+                            e.Bytes({0x89, 0xC2});                  // mov edx, eax
+                            if ((opcode & 0x000Fu) == 0x6) {
+                                e.Bytes({0x83, 0xE2, 0x01});        // and edx, 1
+                            } else {
+                                e.Bytes({0xC1, 0xEA, 0x07});        // shr edx, 7
+                            }
+                            e.Op({0x88}, EDX, out(0xF));            // mov VF, dl
+                            // Reload, Vx may be VF
+                            e.Op({0x0F, 0xB6}, EAX, in(x));         // movzx eax, Vx
+                            e.Bytes({0xD1, static_cast<uint8_t>((opcode & 0x000Fu) == 0x6 ? 0xE8 : 0xE0)});
+                            e.Op({0x88}, EAX, out(x));              // mov Vx, al
+                            break;
+                        default:
+                            break;
+                    }
+                    break;
+                case 0xA:
+                    if (cached[GUEST_INDEX].host >= 0) {
+                        e.Op({0xC7}, 0, out(GUEST_INDEX));  // mov host, nnn
+                        e.Imm32(nnn);
+                    } else {
+                        e.Mem({0x66, 0xC7}, 0, INDEX);      // mov word [index], nnn
+                        e.Imm16(nnn);
+                    }
+                    break;
+                case 0xB:
+                    e.Op({0x0F, 0xB6}, EAX, in(0x0));       // movzx eax, V0
+                    e.Byte(0x05);                           // add eax, nnn
+                    e.Imm32(nnn);
+                    e.Mem({0x66, 0x89}, EAX, PC);           // mov [pc], ax
+                    pendingPc = 0;
+                    break;
+                case 0xF:
+                    if (kk == 0x1E) {
+                        e.Op({0x0F, 0xB6}, EAX, in(x));             // movzx eax, Vx
+                        e.Op({0x01}, EAX, inOut(GUEST_INDEX), true); // add I, ax
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        ++pendingCycles;
+    }
+
+    flushPc();
+    flushCycles();
+    spill(false);
+    if (pad) {
+        e.Bytes({0x48, 0x83, 0xC4, 0x08});      // add rsp, 8
+    }
+    for (unsigned int i = savedCount; i > 0; --i) {
+        e.Pop(saved[i - 1]);
+    }
+    e.Byte(0x5B);                               // pop rbx
+    e.Byte(0xC3);                               // ret
+
+    if (!Protect(code_buffer, code_used, e.size, PROT_READ | PROT_EXEC)) {
+        Release();
+        return;
+    }
+
+    JitBlock &block = blocks[start];
+    block.code = reinterpret_cast<JitCode>(code_buffer + code_used);
+    block.size = address - start;
+    block.instructions = count;
+    code_used += e.size;
+    ++compiled;
+
+    for (uint16_t i = 0; i < block.size; ++i) {
+        ++coverage[(start + i) & 0x0FFFu];
+    }
+}
+
+void Jit::Run(Chip8 &c, unsigned int cycles) {
+    while (cycles > 0) {
+        // Without a code buffer, or once a compile has given it up
+        if (!code_buffer) {
+            for (; cycles > 0; --cycles) {
+                c.Cycle();
+            }
+            return;
+        }
+
+        uint16_t start = c.pc & 0x0FFFu;
+        JitBlock *block = &blocks[start];
+
+        if (!block->code && ++heat[start] >= JIT_THRESHOLD) {
+            Compile(c, start);
+            continue;
+        }
+
+        // Cold code, and the tail of a slice that a whole block would overrun, is interpreted
+        if (!block->code || block->instructions > cycles) {
+            c.Cycle();
+            --cycles;
+            continue;
+        }
+
+        block->code(&c);
+        cycles -= block->instructions;
+    }
+}
+
+void Jit::Invalidate(uint16_t address, uint16_t length) {
+    for (uint16_t i = 0; i < length; ++i) {
+        uint16_t written = (address + i) & 0x0FFFu;
+
+        // Compiled code stays in the buffer until the next flush, so a block may invalidate itself safely
+        for (unsigned int back = 0; back < MAX_BLOCK_INSTRUCTIONS * 2 && coverage[written]; ++back) {
+            uint16_t start = (written - back) & 0x0FFFu;
+            JitBlock &block = blocks[start];
+
+            if (block.code && back < block.size) {
+                for (uint16_t j = 0; j < block.size; ++j) {
+                    --coverage[(start + j) & 0x0FFFu];
+                }
+                block = JitBlock{};
+                heat[start] = 0;
+                ++invalidations;
+            }
+        }
+    }
+}
+
+#else
+
+Jit::Jit() = default;
+
+Jit::~Jit() = default;
+
+void Jit::Run(Chip8 &c, unsigned int cycles) {
+    for (unsigned int i = 0; i < cycles; ++i) {
+        c.Cycle();
+    }
+}
+
+void Jit::Invalidate(uint16_t address, uint16_t length) {}
+
+void Jit::Compile(Chip8 &c, uint16_t start) {}
+
+void Jit::Flush() {}
+
+void Jit::Release() {}
+
+#endif
@@ -0,0 +1,57 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_JIT_H
+#define CHIP8_INTERPRETER_JIT_H
+
+#include "Chip8.h"
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__unix__) || defined(__APPLE__))
+#define CHIP8_JIT_SUPPORTED 1
+#endif
+
+typedef void (*JitCode)(Chip8 *c);
+
+struct JitBlock {
+    JitCode code;
+    uint16_t size;         // in bytes of guest code
+    uint16_t instructions;
+};
+
+// Dynamic recompiler: basic blocks that have run JIT_THRESHOLD times are translated to x86-64 machine code.
+// Arithmetic, loads, jumps, calls and skips are native; Dxyn, Fx0A, timers, RNG and memory writes call back into
+// the interpreter. Anything not (yet) compiled, and every instruction on hosts without JIT support, is run by
+// Chip8::Cycle(). Within a block the guest registers it uses more than once, I included, are kept in host registers
+// and stored back before helper calls and at the end of the block; pc and cycle_count are added up at compile time.
+class Jit {
+public:
+    static const unsigned int JIT_THRESHOLD = 16;
+    static const unsigned int MAX_BLOCK_INSTRUCTIONS = 64;
+    static const size_t CODE_BUFFER_SIZE = 1 << 20;
+
+    Jit();
+    ~Jit();
+
+    void Run(Chip8 &c, unsigned int cycles);
+
+    void Invalidate(uint16_t address, uint16_t length);
+
+    uint64_t compiled{};
+    uint64_t invalidations{};
+    uint64_t flushes{};
+
+private:
+    void Compile(Chip8 &c, uint16_t start);
+    void Flush();
+    void Release();
+
+    uint8_t *code_buffer{};
+    size_t code_used{};
+
+    JitBlock blocks[4096]{};
+    uint16_t heat[4096]{};
+    uint8_t coverage[4096]{};
+};
+
+#endif //CHIP8_INTERPRETER_JIT_H
@@ -0,0 +1,84 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "LatencyTracker.h"
+#include <algorithm>
+
+using namespace std;
+
+static const auto OBSERVE_TIMEOUT = chrono::seconds(1);
+
+void LatencyTracker::KeyApplied(Chip8 &c, KeyEvent const &event) {
+    // Reads before this event don't count for it
+    c.key_read_cycle[event.key & 0xFu] = UINT64_MAX;
+
+    if (event.pressed) {
+        pending.push_back({event.time, static_cast<uint8_t>(event.key & 0xFu), c.cycle_count, UINT64_MAX});
+    }
+}
+
+void LatencyTracker::FrameEnded(Chip8 &c, uint64_t frame) {
+    auto now = chrono::steady_clock::now();
+
+    auto done = remove_if(pending.begin(), pending.end(), [&](Pending &press) {
+        if (press.read == UINT64_MAX && c.key_read_cycle[press.key] != UINT64_MAX) {
+            press.read = c.key_read_cycle[press.key];
+        }
+
+        // A draw after the read has to be in this frame, earlier frames would have caught it
+        if (press.read != UINT64_MAX && c.draw_cycle > press.read) {
+            if (!reflected.Push({press.time, frame})) {
+                ++dropped;
+            }
+            return true;
+        }
+
+        if (now - press.time > OBSERVE_TIMEOUT) {
+            ++unobserved;
+            return true;
+        }
+        return false;
+    });
+    pending.erase(done, pending.end());
+}
+
+void LatencyTracker::FramePresented(uint64_t frame, chrono::steady_clock::time_point presentedAt) {
+    Reflected press;
+    while (reflected.Peek(press) && press.frame <= frame) {
+        double ms = chrono::duration<double, milli>(presentedAt - press.time).count();
+        ++buckets[min<size_t>(static_cast<size_t>(ms * BUCKETS_PER_MS), MAX_MS * BUCKETS_PER_MS)];
+        ++samples;
+        max_ms = max(max_ms, ms);
+        reflected.Pop();
+    }
+}
+
+// Upper edge of the bucket holding the given fraction of samples
+double LatencyTracker::Percentile(double fraction) const {
+    uint64_t target = static_cast<uint64_t>(fraction * samples);
+    uint64_t seen = 0;
+    for (size_t i = 0; i <= MAX_MS * BUCKETS_PER_MS; ++i) {
+        seen += buckets[i];
+        if (seen > target) {
+            return min(static_cast<double>(i + 1) / BUCKETS_PER_MS, max_ms);
+        }
+    }
+    return max_ms;
+}
+
+void LatencyTracker::Report(FILE *out, bool histogram) const {
+    std::fprintf(out, "input latency: %llu presses, p50 %.1f ms, p99 %.1f ms, max %.1f ms, %llu unobserved\n",
+                 static_cast<unsigned long long>(samples), samples ? Percentile(0.5) : 0.0,
+                 samples ? Percentile(0.99) : 0.0, max_ms, static_cast<unsigned long long>(unobserved + dropped));
+
+    if (histogram) {
+        std::fprintf(out, "# bucket start ms, presses\n");
+        for (size_t i = 0; i <= MAX_MS * BUCKETS_PER_MS; ++i) {
+            if (buckets[i]) {
+                std::fprintf(out, "%.1f %llu\n", static_cast<double>(i) / BUCKETS_PER_MS,
+                             static_cast<unsigned long long>(buckets[i]));
+            }
+        }
+    }
+}
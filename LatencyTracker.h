@@ -0,0 +1,60 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_LATENCYTRACKER_H
+#define CHIP8_INTERPRETER_LATENCYTRACKER_H
+
+#include "Chip8.h"
+#include "Input.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// Input-to-photon latency: each key press is followed from the moment it was polled, through the first Ex9E, ExA1
+// or Fx0A that reads the key, to the first draw after that read and the present of the frame holding it.
+// Presses that the program doesn't read and draw within a second are counted as unobserved.
+class LatencyTracker {
+public:
+    static const unsigned int BUCKETS_PER_MS = 10;
+    static const unsigned int MAX_MS = 1000;
+
+    // Emulation thread: a key event was applied to c
+    void KeyApplied(Chip8 &c, KeyEvent const &event);
+
+    // Emulation thread: a frame finished running. Call before publishing it as frame number frame
+    void FrameEnded(Chip8 &c, uint64_t frame);
+
+    // Presentation thread: frame number frame reached the screen
+    void FramePresented(uint64_t frame, chrono::steady_clock::time_point presentedAt);
+
+    // Once both threads are done: p50/p99/max summary, plus the histogram when writing to a file
+    void Report(FILE *out, bool histogram) const;
+
+private:
+    struct Pending {
+        chrono::steady_clock::time_point time;
+        uint8_t key;
+        uint64_t applied;   // cycle the press was applied at
+        uint64_t read;      // first cycle the key was read at afterwards, UINT64_MAX until then
+    };
+
+    struct Reflected {
+        chrono::steady_clock::time_point time;
+        uint64_t frame;
+    };
+
+    double Percentile(double fraction) const;
+
+    vector<Pending> pending;
+    SpscQueue<Reflected, 1024> reflected;
+
+    // Buckets of 1/BUCKETS_PER_MS ms, the last one collects everything from MAX_MS up
+    uint64_t buckets[MAX_MS * BUCKETS_PER_MS + 1]{};
+    uint64_t samples{};
+    double max_ms{};
+    uint64_t unobserved{};
+    uint64_t dropped{};
+};
+
+#endif //CHIP8_INTERPRETER_LATENCYTRACKER_H
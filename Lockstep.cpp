@@ -0,0 +1,540 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "Lockstep.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+static const unsigned int LANES = LockstepGroup::LANES;
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CHIP8_LOCKSTEP_VECTORS 1
+
+// GCC/Clang vector extensions: one operation on every lane, lowered to whatever vector instructions the target has
+typedef uint8_t LaneBytes __attribute__((vector_size(LANES), may_alias));
+typedef uint16_t LaneWords __attribute__((vector_size(LANES * 2), may_alias));
+
+#define SPLAT8(value) (LaneBytes{} + static_cast<uint8_t>(value))
+#define SPLAT16(value) (LaneWords{} + static_cast<uint16_t>(value))
+#define WIDEN(bytes) __builtin_convertvector(bytes, LaneWords)
+// Lanes set in mask take a, the others keep b
+#define SELECT(mask, a, b) (((a) & (mask)) | ((b) & ~(mask)))
+
+// Stepping a group is compiled for AVX-512 and AVX2 as well, and picked at load time for the CPU
+#if defined(__x86_64__) && defined(__linux__) && !defined(__clang__)
+#define CHIP8_LOCKSTEP_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define CHIP8_LOCKSTEP_CLONES
+#endif
+
+template<typename V>
+static bool AllZero(V const &v) {
+    uint64_t words[sizeof(V) / sizeof(uint64_t)];
+    std::memcpy(words, &v, sizeof(V));
+    uint64_t any = 0;
+    for (uint64_t word: words) {
+        any |= word;
+    }
+    return !any;
+}
+#endif
+
+static uint8_t timerValue(uint8_t value, uint64_t setTick, uint64_t currentTick) {
+    uint64_t elapsed = currentTick - setTick;
+    return elapsed >= value ? 0 : static_cast<uint8_t>(value - elapsed);
+}
+
+static uint16_t OpcodeAt(uint8_t const *memory, uint16_t address) {
+    return (memory[address & 0x0FFFu] << 8u) | memory[(address + 1) & 0x0FFFu];
+}
+
+LockstepGroup::LockstepGroup(Chip8 const &prototype, unsigned int lanes) : lanes(std::min(lanes, LANES)) {
+    vector_lanes = this->lanes == LANES ? 0xFFFFFFFFu : (1u << this->lanes) - 1;
+    for (unsigned int lane = 0; lane < this->lanes; ++lane) {
+        ImportLane(lane, prototype);
+    }
+    std::fill(begin(page_uniform), end(page_uniform), true);
+
+#ifndef CHIP8_LOCKSTEP_VECTORS
+    // No vector extensions: every lane is interpreted on its own
+    for (unsigned int lane = 0; lane < this->lanes; ++lane) {
+        Split(lane, 0);
+    }
+#endif
+}
+
+LockstepGroup::~LockstepGroup() = default;
+
+void LockstepGroup::ImportLane(unsigned int lane, Chip8 const &c) {
+    split[lane].reset();
+    window_steps[lane] = 0;
+    window_lanes[lane] = 0;
+    vector_lanes |= 1u << lane;
+
+    for (unsigned int r = 0; r < 16; ++r) {
+        registers[r][lane] = c.registers[r];
+        stack[r][lane] = c.stack[r];
+    }
+    pc[lane] = c.pc;
+    index[lane] = c.index;
+    keypad[lane] = c.keypad.load(memory_order_relaxed);
+    sp[lane] = c.sp;
+    delay_timer[lane] = c.delay_timer;
+    sound_timer[lane] = c.sound_timer;
+    delay_timer_tick[lane] = c.delay_timer_tick;
+    sound_timer_tick[lane] = c.sound_timer_tick;
+    cycle_count[lane] = c.cycle_count;
+    clock_base_cycle[lane] = c.clock_base_cycle;
+    clock_base_tick[lane] = c.clock_base_tick;
+    // Never 0, TickAt divides by it (as Chip8::SetClockRate ensures)
+    cycles_per_second[lane] = std::max(c.cycles_per_second, 1u);
+    rng[lane] = c.rng;
+    std::memcpy(display[lane], c.display, sizeof(display[lane]));
+    c.memory.Load(0, memory[lane], sizeof(memory[lane]));
+
+    // Pages where this lane now differs from the others can't be decoded once for everyone any more
+    for (unsigned int other = 0; other < lanes; ++other) {
+        if (other != lane && ((vector_lanes >> other) & 1u)) {
+            for (unsigned int page = 0; page < 4096 / PAGE_SIZE; ++page) {
+                if (std::memcmp(memory[lane] + page * PAGE_SIZE, memory[other] + page * PAGE_SIZE, PAGE_SIZE) != 0) {
+                    page_uniform[page] = false;
+                }
+            }
+            break;
+        }
+    }
+}
+
+void LockstepGroup::ExportLane(unsigned int lane, Chip8 &c) const {
+    if (split[lane]) {
+        c.ForkFrom(*split[lane]);
+        return;
+    }
+
+    for (unsigned int r = 0; r < 16; ++r) {
+        c.registers[r] = registers[r][lane];
+        c.stack[r] = stack[r][lane];
+    }
+    c.pc = pc[lane];
+    c.index = index[lane];
+    c.keypad.store(keypad[lane], memory_order_relaxed);
+    c.sp = sp[lane];
+    c.delay_timer = delay_timer[lane];
+    c.sound_timer = sound_timer[lane];
+    c.delay_timer_tick = delay_timer_tick[lane];
+    c.sound_timer_tick = sound_timer_tick[lane];
+    c.cycle_count = cycle_count[lane];
+    c.clock_base_cycle = clock_base_cycle[lane];
+    c.clock_base_tick = clock_base_tick[lane];
+    c.cycles_per_second = cycles_per_second[lane];
+    c.rng = rng[lane];
+    std::memcpy(c.display, display[lane], sizeof(c.display));
+    c.dirty_rows = 0xFFFFFFFF;
+    c.memory.Store(0, memory[lane], sizeof(memory[lane]));
+    c.MemoryWritten(0, PagedMemory::SIZE);
+}
+
+void LockstepGroup::Seed(unsigned int lane, uint64_t seed, uint64_t stream) {
+    if (split[lane]) {
+        split[lane]->Seed(seed, stream);
+    } else {
+        rng[lane].Seed(seed, stream);
+    }
+}
+
+void LockstepGroup::SetKeypad(unsigned int lane, uint16_t keys) {
+    if (split[lane]) {
+        split[lane]->keypad.store(keys, memory_order_relaxed);
+    } else {
+        keypad[lane] = keys;
+    }
+}
+
+uint64_t LockstepGroup::TickAt(unsigned int lane, uint64_t cycle) const {
+    return clock_base_tick[lane] + (cycle - clock_base_cycle[lane]) * Chip8::TIMER_RATE / cycles_per_second[lane];
+}
+
+// A page stays uniform only while a write leaves the same bytes in every lane
+void LockstepGroup::MemoryWritten(uint16_t address, uint16_t length) {
+    unsigned int first = __builtin_ctz(vector_lanes);
+    for (uint16_t i = 0; i < length; ++i) {
+        uint16_t a = (address + i) & 0x0FFFu;
+        if (!page_uniform[a / PAGE_SIZE]) {
+            continue;
+        }
+        for (uint32_t bits = vector_lanes; bits; bits &= bits - 1) {
+            if (memory[__builtin_ctz(bits)][a] != memory[first][a]) {
+                page_uniform[a / PAGE_SIZE] = false;
+                break;
+            }
+        }
+    }
+}
+
+void LockstepGroup::Split(unsigned int lane, unsigned int remaining) {
+    auto chip8 = make_unique<Chip8>();
+    ExportLane(lane, *chip8);
+    split[lane] = std::move(chip8);
+    vector_lanes &= ~(1u << lane);
+    left[lane] = 0;
+    ++splits;
+
+    // Every backend ends in the same state as Chip8::Cycle() in a loop (see --bench), so take the fastest
+    split[lane]->dispatch_mode = DispatchMode::Specialized;
+    split[lane]->Run(remaining);
+}
+
+void LockstepGroup::Run(unsigned int cycles) {
+    for (unsigned int lane = 0; lane < lanes; ++lane) {
+        if (split[lane]) {
+            split[lane]->Run(cycles);
+        } else {
+            left[lane] = cycles;
+        }
+    }
+
+#ifdef CHIP8_LOCKSTEP_VECTORS
+    for (;;) {
+        uint32_t running = 0;
+        uint32_t mostLeft = 0;
+        for (uint32_t bits = vector_lanes; bits; bits &= bits - 1) {
+            unsigned int lane = __builtin_ctz(bits);
+            if (left[lane]) {
+                running |= 1u << lane;
+                mostLeft = std::max(mostLeft, left[lane]);
+            }
+        }
+        if (!running) {
+            break;
+        }
+
+        // Of the lanes not too far ahead, the one at the lowest pc leads: lanes that took the short side of a
+        // branch wait where the long side comes back, and catch up with the rest at backward jumps
+        uint32_t eligible = 0;
+        unsigned int leader = LANES;
+        for (uint32_t bits = running; bits; bits &= bits - 1) {
+            unsigned int lane = __builtin_ctz(bits);
+            if (left[lane] + MAX_LANE_LAG >= mostLeft) {
+                eligible |= 1u << lane;
+                if (leader == LANES || pc[lane] < pc[leader]) {
+                    leader = lane;
+                }
+            }
+        }
+
+        // Every running lane at the leader's pc joins in, if it would decode the same instruction
+        uint16_t address = pc[leader];
+        uint16_t opcode = OpcodeAt(memory[leader], address);
+        bool uniform = page_uniform[(address & 0x0FFFu) / PAGE_SIZE] && page_uniform[((address + 1) & 0x0FFFu) / PAGE_SIZE];
+        uint32_t group = 0;
+        uint32_t steps = MAX_LANE_LAG;
+        for (uint32_t bits = running; bits; bits &= bits - 1) {
+            unsigned int lane = __builtin_ctz(bits);
+            if (pc[lane] == address && (uniform || OpcodeAt(memory[lane], address) == opcode)) {
+                group |= 1u << lane;
+                steps = std::min(steps, left[lane]);
+            }
+        }
+
+        unsigned int ran = RunGroup(group, leader, eligible & ~group, steps);
+
+        unsigned int groupLanes = __builtin_popcount(group);
+        group_steps += ran;
+        lane_steps += static_cast<uint64_t>(ran) * groupLanes;
+
+        for (uint32_t bits = group; bits; bits &= bits - 1) {
+            unsigned int lane = __builtin_ctz(bits);
+            left[lane] -= ran;
+            cycle_count[lane] += ran;
+
+            // Lanes that keep ending up in small groups are cheaper to interpret
+            window_steps[lane] += ran;
+            window_lanes[lane] += ran * groupLanes;
+            if (window_steps[lane] >= SPLIT_WINDOW) {
+                if (window_lanes[lane] < window_steps[lane] * MIN_GROUP_LANES) {
+                    Split(lane, left[lane]);
+                }
+                window_steps[lane] = 0;
+                window_lanes[lane] = 0;
+            }
+        }
+    }
+#endif
+}
+
+#ifdef CHIP8_LOCKSTEP_VECTORS
+
+// Run the lanes in group, all at the leader's pc, for up to maxSteps instructions. Stops early once they branch
+// apart, or once one of the waiting lanes is at or before their pc so it can join or lead. Returns the number of
+// instructions run.
+CHIP8_LOCKSTEP_CLONES
+unsigned int LockstepGroup::RunGroup(uint32_t group, unsigned int leader, uint32_t waiting, unsigned int maxSteps) {
+    LaneBytes g8{};
+    LaneWords g16{};
+    LaneWords w16{};
+    for (unsigned int lane = 0; lane < LANES; ++lane) {
+        g8[lane] = (group >> lane) & 1u ? 0xFF : 0;
+        g16[lane] = (group >> lane) & 1u ? 0xFFFF : 0;
+        w16[lane] = (waiting >> lane) & 1u ? 0xFFFF : 0;
+    }
+
+    auto &V = *reinterpret_cast<LaneBytes (*)[16]>(registers);
+    auto &PC = *reinterpret_cast<LaneWords *>(pc);
+    auto &I = *reinterpret_cast<LaneWords *>(index);
+    auto &K = *reinterpret_cast<LaneWords *>(keypad);
+
+    unsigned int steps = 0;
+    while (steps < maxSteps) {
+        uint16_t address = pc[leader];
+        uint16_t opcode = OpcodeAt(memory[leader], address);
+
+        // Lanes whose copies of this page differ may be about to run different instructions
+        if (steps > 0 && !(page_uniform[(address & 0x0FFFu) / PAGE_SIZE] &&
+                           page_uniform[((address + 1) & 0x0FFFu) / PAGE_SIZE])) {
+            bool same = true;
+            for (uint32_t bits = group; bits && same; bits &= bits - 1) {
+                same = OpcodeAt(memory[__builtin_ctz(bits)], address) == opcode;
+            }
+            if (!same) {
+                break;
+            }
+        }
+
+        PC = PC + (g16 & SPLAT16(2));
+
+        uint8_t x = (opcode & 0x0F00u) >> 8u;
+        uint8_t y = (opcode & 0x00F0u) >> 4u;
+        uint8_t kk = opcode & 0x00FFu;
+        uint8_t n = opcode & 0x000Fu;
+        uint16_t nnn = opcode & 0x0FFFu;
+        uint64_t cycleOffset = steps;
+        // Set when the lanes may now be at different pcs
+        bool branched = false;
+
+        switch (opcode >> 12u) {
+            case 0x0:
+                if (n == 0x0) {
+                    for (uint32_t bits = group; bits; bits &= bits - 1) {
+                        std::memset(display[__builtin_ctz(bits)], 0, sizeof(display[0]));
+                    }
+                } else if (n == 0xE) {
+                    for (uint32_t bits = group; bits; bits &= bits - 1) {
+                        unsigned int lane = __builtin_ctz(bits);
+                        --sp[lane];
+                        pc[lane] = stack[sp[lane] & 0xFu][lane];
+                    }
+                    branched = true;
+                }
+                break;
+            case 0x1:
+                PC = SELECT(g16, SPLAT16(nnn), PC);
+                break;
+            case 0x2:
+                for (uint32_t bits = group; bits; bits &= bits - 1) {
+                    unsigned int lane = __builtin_ctz(bits);
+                    stack[sp[lane] & 0xFu][lane] = pc[lane];
+                    ++sp[lane];
+                }
+                PC = SELECT(g16, SPLAT16(nnn), PC);
+                break;
+            case 0x3:
+                PC = PC + (WIDEN((LaneBytes) (V[x] == SPLAT8(kk)) & g8) & SPLAT16(2));
+                branched = true;
+                break;
+            case 0x4:
+                PC = PC + (WIDEN((LaneBytes) (V[x] != SPLAT8(kk)) & g8) & SPLAT16(2));
+                branched = true;
+                break;
+            case 0x5:
+                PC = PC + (WIDEN((LaneBytes) (V[x] == V[y]) & g8) & SPLAT16(2));
+                branched = true;
+                break;
+            case 0x6:
+                V[x] = SELECT(g8, SPLAT8(kk), V[x]);
+                break;
+            case 0x7:
+                V[x] = V[x] + (SPLAT8(kk) & g8);
+                break;
+            case 0x8: {
+                // Same order of reads and writes as Instructions.h, so x or y being F behaves the same
+                LaneBytes a = V[x];
+                LaneBytes b = V[y];
+                switch (n) {
+                    case 0x0:
+                        V[x] = SELECT(g8, b, a);
+                        break;
+                    case 0x1:
+                        V[x] = a | (b & g8);
+                        break;
+                    case 0x2:
+                        V[x] = a & (b | ~g8);
+                        break;
+                    case 0x3:
+                        V[x] = a ^ (b & g8);
+                        break;
+                    case 0x4:
+                        V[0xF] = SELECT(g8, (LaneBytes) (b > ~a) & SPLAT8(1), V[0xF]);
+                        V[x] = SELECT(g8, a + b, V[x]);
+                        break;
+                    case 0x5:
+                        V[0xF] = SELECT(g8, (LaneBytes) (a != b) & SPLAT8(1), V[0xF]);
+                        V[x] = SELECT(g8, a - b, V[x]);
+                        break;
+                    case 0x6:
+                        V[0xF] = SELECT(g8, V[x] & SPLAT8(1), V[0xF]);
+                        V[x] = SELECT(g8, V[x] >> SPLAT8(1), V[x]);
+                        break;
+                    case 0x7:
+                        V[0xF] = SELECT(g8, (LaneBytes) (a == b) & SPLAT8(1), V[0xF]);
+                        V[x] = SELECT(g8, a - b, V[x]);
+                        break;
+                    case 0xE:
+                        V[0xF] = SELECT(g8, V[x] >> SPLAT8(7), V[0xF]);
+                        V[x] = SELECT(g8, V[x] << SPLAT8(1), V[x]);
+                        break;
+                    default:
+                        break;
+                }
+                break;
+            }
+            case 0x9:
+                PC = PC + (WIDEN((LaneBytes) (V[x] != V[y]) & g8) & SPLAT16(2));
+                branched = true;
+                break;
+            case 0xA:
+                I = SELECT(g16, SPLAT16(nnn), I);
+                break;
+            case 0xB:
+                PC = SELECT(g16, WIDEN(V[0]) + SPLAT16(nnn), PC);
+                branched = true;
+                break;
+            case 0xC:
+                for (uint32_t bits = group; bits; bits &= bits - 1) {
+                    unsigned int lane = __builtin_ctz(bits);
+                    registers[x][lane] = kk & rng[lane].NextByte();
+                }
+                break;
+            case 0xD:
+                for (uint32_t bits = group; bits; bits &= bits - 1) {
+                    unsigned int lane = __builtin_ctz(bits);
+                    uint8_t xPos = registers[x][lane] % 64;
+                    uint8_t yPos = registers[y][lane] % 32;
+                    uint64_t collision = 0;
+                    for (unsigned int row = 0; row < n && yPos + row < 32; ++row) {
+                        uint64_t spriteRow = (uint64_t(memory[lane][(index[lane] + row) & 0x0FFFu]) << 56u) >> xPos;
+                        collision |= display[lane][yPos + row] & spriteRow;
+                        display[lane][yPos + row] ^= spriteRow;
+                    }
+                    registers[0xF][lane] = collision != 0;
+                }
+                break;
+            case 0xE: {
+                LaneWords pressed = (K >> WIDEN(V[x] & SPLAT8(0xF))) & SPLAT16(1);
+                if (n == 0xE) {
+                    PC = PC + ((pressed + pressed) & g16);
+                    branched = true;
+                } else if (n == 0x1) {
+                    PC = PC + (((pressed ^ SPLAT16(1)) + (pressed ^ SPLAT16(1))) & g16);
+                    branched = true;
+                }
+                break;
+            }
+            case 0xF:
+                switch (kk) {
+                    case 0x07:
+                        for (uint32_t bits = group; bits; bits &= bits - 1) {
+                            unsigned int lane = __builtin_ctz(bits);
+                            registers[x][lane] = timerValue(delay_timer[lane], delay_timer_tick[lane],
+                                                            TickAt(lane, cycle_count[lane] + cycleOffset));
+                        }
+                        break;
+                    case 0x0A:
+                        for (uint32_t bits = group; bits; bits &= bits - 1) {
+                            unsigned int lane = __builtin_ctz(bits);
+                            if (keypad[lane]) {
+                                registers[x][lane] = __builtin_ctz(keypad[lane]);
+                            } else {
+                                pc[lane] -= 2;
+                            }
+                        }
+                        branched = true;
+                        break;
+                    case 0x15:
+                        for (uint32_t bits = group; bits; bits &= bits - 1) {
+                            unsigned int lane = __builtin_ctz(bits);
+                            delay_timer[lane] = registers[x][lane];
+                            delay_timer_tick[lane] = TickAt(lane, cycle_count[lane] + cycleOffset);
+                        }
+                        break;
+                    case 0x18:
+                        for (uint32_t bits = group; bits; bits &= bits - 1) {
+                            unsigned int lane = __builtin_ctz(bits);
+                            sound_timer[lane] = registers[x][lane];
+                            sound_timer_tick[lane] = TickAt(lane, cycle_count[lane] + cycleOffset);
+                        }
+                        break;
+                    case 0x1E:
+                        I = I + (WIDEN(V[x]) & g16);
+                        break;
+                    case 0x29:
+                        for (uint32_t bits = group; bits; bits &= bits - 1) {
+                            unsigned int lane = __builtin_ctz(bits);
+                            index[lane] = memory[lane][Chip8::FONTSET_START_ADDRESS + registers[x][lane] * 5];
+                        }
+                        break;
+                    case 0x33:
+                        for (uint32_t bits = group; bits; bits &= bits - 1) {
+                            unsigned int lane = __builtin_ctz(bits);
+                            uint8_t value = registers[x][lane];
+                            memory[lane][(index[lane] + 2) & 0x0FFFu] = value % 10;
+                            memory[lane][(index[lane] + 1) & 0x0FFFu] = (value / 10) % 10;
+                            memory[lane][index[lane] & 0x0FFFu] = value / 100;
+                        }
+                        for (uint32_t bits = group; bits; bits &= bits - 1) {
+                            MemoryWritten(index[__builtin_ctz(bits)] & 0x0FFFu, 3);
+                        }
+                        break;
+                    case 0x55:
+                        for (uint32_t bits = group; bits; bits &= bits - 1) {
+                            unsigned int lane = __builtin_ctz(bits);
+                            for (uint8_t i = 0; i <= x; i++) {
+                                memory[lane][(index[lane] + i) & 0x0FFFu] = registers[i][lane];
+                            }
+                        }
+                        for (uint32_t bits = group; bits; bits &= bits - 1) {
+                            MemoryWritten(index[__builtin_ctz(bits)] & 0x0FFFu, x + 1);
+                        }
+                        break;
+                    case 0x65:
+                        for (uint32_t bits = group; bits; bits &= bits - 1) {
+                            unsigned int lane = __builtin_ctz(bits);
+                            for (uint8_t i = 0; i <= x; i++) {
+                                registers[i][lane] = memory[lane][(index[lane] + i) & 0x0FFFu];
+                            }
+                        }
+                        break;
+                    default:
+                        break;
+                }
+                break;
+            default:
+                break;
+        }
+
+        ++steps;
+
+        LaneWords leaderPc = SPLAT16(pc[leader]);
+        if (branched && !AllZero((LaneWords) (PC != leaderPc) & g16)) {
+            break;
+        }
+        if (waiting && !AllZero((LaneWords) (PC <= leaderPc) & w16)) {
+            break;
+        }
+    }
+    return steps;
+}
+
+#endif
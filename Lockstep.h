@@ -0,0 +1,92 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_LOCKSTEP_H
+#define CHIP8_INTERPRETER_LOCKSTEP_H
+
+#include "Chip8.h"
+
+// Up to LANES instances of one program stepped together. The state is kept as structure-of-arrays, one lane per
+// instance: each instruction is decoded once for every lane at the same pc, and register, pc and index updates are
+// vector operations over all lanes. Lanes that branch apart are masked out while the others run and merge again
+// when their pcs meet; a lane that mostly runs in small groups is split off into its own Chip8 and interpreted.
+// Every lane ends in exactly the state Chip8::Cycle() would have left it in.
+// Around 140 KB, so allocate it on the heap.
+class LockstepGroup {
+public:
+    static constexpr unsigned int LANES = 32;
+    // Furthest a lane may get ahead of the slowest one before the group waits for it
+    static constexpr unsigned int MAX_LANE_LAG = 64;
+    // A lane is split off when, over SPLIT_WINDOW of its instructions, the groups it ran in averaged fewer than
+    // MIN_GROUP_LANES lanes: below that, stepping the group costs more than interpreting its lanes one by one
+    static constexpr unsigned int SPLIT_WINDOW = 1024;
+    static constexpr unsigned int MIN_GROUP_LANES = 8;
+
+    // Every lane starts as a copy of prototype (loaded ROM, clock rate, timers)
+    LockstepGroup(Chip8 const &prototype, unsigned int lanes);
+    ~LockstepGroup();
+
+    unsigned int Lanes() const {
+        return lanes;
+    }
+
+    void Seed(unsigned int lane, uint64_t seed, uint64_t stream = Pcg32::DEFAULT_STREAM);
+    void SetKeypad(unsigned int lane, uint16_t keys);
+
+    // Run cycles instructions on every lane
+    void Run(unsigned int cycles);
+
+    // Copy a lane's state into a Chip8, e.g. to compare it with one that ran on its own
+    void ExportLane(unsigned int lane, Chip8 &c) const;
+    void ImportLane(unsigned int lane, Chip8 const &c);
+
+    bool IsSplit(unsigned int lane) const {
+        return split[lane] != nullptr;
+    }
+
+    // Instructions decoded once for a group of lanes, and lane instructions executed by them
+    uint64_t group_steps{};
+    uint64_t lane_steps{};
+    uint64_t splits{};
+
+    // Per-lane state, [register][lane] so one register of every lane is one vector
+    alignas(64) uint8_t registers[16][LANES]{};
+    alignas(64) uint16_t pc[LANES]{};
+    alignas(64) uint16_t index[LANES]{};
+    alignas(64) uint16_t keypad[LANES]{};
+    alignas(64) uint16_t stack[16][LANES]{};
+    uint8_t sp[LANES]{};
+    uint8_t delay_timer[LANES]{};
+    uint8_t sound_timer[LANES]{};
+    uint64_t delay_timer_tick[LANES]{};
+    uint64_t sound_timer_tick[LANES]{};
+    uint64_t cycle_count[LANES]{};
+    uint64_t clock_base_cycle[LANES]{};
+    uint64_t clock_base_tick[LANES]{};
+    unsigned int cycles_per_second[LANES]{};
+    Pcg32 rng[LANES];
+    uint64_t display[LANES][32]{};
+    alignas(64) uint8_t memory[LANES][4096]{};
+
+    // 256-byte memory pages that are the same in every lane, so one lane's copy can be decoded for all of them
+    static constexpr unsigned int PAGE_SIZE = 256;
+    bool page_uniform[4096 / PAGE_SIZE]{};
+
+private:
+    unsigned int RunGroup(uint32_t group, unsigned int leader, uint32_t waiting, unsigned int maxSteps);
+    uint64_t TickAt(unsigned int lane, uint64_t cycle) const;
+    void MemoryWritten(uint16_t address, uint16_t length);
+    void Split(unsigned int lane, unsigned int remaining);
+
+    unsigned int lanes;
+    // Lanes still stepped here, bit l for lane l
+    uint32_t vector_lanes{};
+    uint32_t left[LANES]{};
+    // Instructions run in the current split window, and the sum of their group sizes
+    uint32_t window_steps[LANES]{};
+    uint32_t window_lanes[LANES]{};
+    unique_ptr<Chip8> split[LANES];
+};
+
+#endif //CHIP8_INTERPRETER_LOCKSTEP_H
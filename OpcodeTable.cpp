@@ -0,0 +1,134 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "OpcodeTable.h"
+#include "Instructions.h"
+#include <array>
+#include <utility>
+
+#ifndef CHIP8_COMPACT_OPCODE_TABLE
+
+// One handler per instruction and operand combination, e.g. OP_8xy4<x, y>, so nothing is decoded at run time
+namespace Specialized {
+
+    void OP_NULL(Chip8 &) {}
+
+    void OP_00E0(Chip8 &c) { Instructions::OP_00E0(c); }
+    void OP_00EE(Chip8 &c) { Instructions::OP_00EE(c); }
+    template<uint16_t nnn> void OP_1nnn(Chip8 &c) { Instructions::OP_1nnn(c, nnn); }
+    template<uint16_t nnn> void OP_2nnn(Chip8 &c) { Instructions::OP_2nnn(c, nnn); }
+    template<uint8_t x, uint8_t kk> void OP_3xkk(Chip8 &c) { Instructions::OP_3xkk(c, x, kk); }
+    template<uint8_t x, uint8_t kk> void OP_4xkk(Chip8 &c) { Instructions::OP_4xkk(c, x, kk); }
+    template<uint8_t x, uint8_t y> void OP_5xy0(Chip8 &c) { Instructions::OP_5xy0(c, x, y); }
+    template<uint8_t x, uint8_t kk> void OP_6xkk(Chip8 &c) { Instructions::OP_6xkk(c, x, kk); }
+    template<uint8_t x, uint8_t kk> void OP_7xkk(Chip8 &c) { Instructions::OP_7xkk(c, x, kk); }
+    template<uint8_t x, uint8_t y> void OP_8xy0(Chip8 &c) { Instructions::OP_8xy0(c, x, y); }
+    template<uint8_t x, uint8_t y> void OP_8xy1(Chip8 &c) { Instructions::OP_8xy1(c, x, y); }
+    template<uint8_t x, uint8_t y> void OP_8xy2(Chip8 &c) { Instructions::OP_8xy2(c, x, y); }
+    template<uint8_t x, uint8_t y> void OP_8xy3(Chip8 &c) { Instructions::OP_8xy3(c, x, y); }
+    template<uint8_t x, uint8_t y> void OP_8xy4(Chip8 &c) { Instructions::OP_8xy4(c, x, y); }
+    template<uint8_t x, uint8_t y> void OP_8xy5(Chip8 &c) { Instructions::OP_8xy5(c, x, y); }
+    template<uint8_t x> void OP_8xy6(Chip8 &c) { Instructions::OP_8xy6(c, x); }
+    template<uint8_t x, uint8_t y> void OP_8xy7(Chip8 &c) { Instructions::OP_8xy7(c, x, y); }
+    template<uint8_t x> void OP_8xyE(Chip8 &c) { Instructions::OP_8xyE(c, x); }
+    template<uint8_t x, uint8_t y> void OP_9xy0(Chip8 &c) { Instructions::OP_9xy0(c, x, y); }
+    template<uint16_t nnn> void OP_Annn(Chip8 &c) { Instructions::OP_Annn(c, nnn); }
+    template<uint16_t nnn> void OP_Bnnn(Chip8 &c) { Instructions::OP_Bnnn(c, nnn); }
+    template<uint8_t x, uint8_t kk> void OP_Cxkk(Chip8 &c) { Instructions::OP_Cxkk(c, x, kk); }
+    template<uint8_t x, uint8_t y, uint8_t n> void OP_Dxyn(Chip8 &c) { Instructions::OP_Dxyn(c, x, y, n); }
+    template<uint8_t x> void OP_Ex9E(Chip8 &c) { Instructions::OP_Ex9E(c, x); }
+    template<uint8_t x> void OP_ExA1(Chip8 &c) { Instructions::OP_ExA1(c, x); }
+    template<uint8_t x> void OP_Fx07(Chip8 &c) { Instructions::OP_Fx07(c, x); }
+    template<uint8_t x> void OP_Fx0A(Chip8 &c) { Instructions::OP_Fx0A(c, x); }
+    template<uint8_t x> void OP_Fx15(Chip8 &c) { Instructions::OP_Fx15(c, x); }
+    template<uint8_t x> void OP_Fx18(Chip8 &c) { Instructions::OP_Fx18(c, x); }
+    template<uint8_t x> void OP_Fx1E(Chip8 &c) { Instructions::OP_Fx1E(c, x); }
+    template<uint8_t x> void OP_Fx29(Chip8 &c) { Instructions::OP_Fx29(c, x); }
+    template<uint8_t x> void OP_Fx33(Chip8 &c) { Instructions::OP_Fx33(c, x); }
+    template<uint8_t x> void OP_Fx55(Chip8 &c) { Instructions::OP_Fx55(c, x); }
+    template<uint8_t x> void OP_Fx65(Chip8 &c) { Instructions::OP_Fx65(c, x); }
+
+    // Pick the handler for one opcode. if constexpr keeps the templates of the other instructions from being
+    // instantiated, so only the combinations that are actually reachable get generated.
+    template<uint16_t op>
+    constexpr OpcodeHandler HandlerFor() {
+        constexpr uint8_t x = (op & 0x0F00u) >> 8u;
+        constexpr uint8_t y = (op & 0x00F0u) >> 4u;
+        constexpr uint8_t kk = op & 0x00FFu;
+        constexpr uint8_t n = op & 0x000Fu;
+        constexpr uint16_t nnn = op & 0x0FFFu;
+        constexpr uint8_t group = op >> 12u;
+
+        if constexpr (group == 0x0) {
+            if constexpr (n == 0x0) return &OP_00E0;
+            else if constexpr (n == 0xE) return &OP_00EE;
+            else return &OP_NULL;
+        } else if constexpr (group == 0x1) return &OP_1nnn<nnn>;
+        else if constexpr (group == 0x2) return &OP_2nnn<nnn>;
+        else if constexpr (group == 0x3) return &OP_3xkk<x, kk>;
+        else if constexpr (group == 0x4) return &OP_4xkk<x, kk>;
+        else if constexpr (group == 0x5) return &OP_5xy0<x, y>;
+        else if constexpr (group == 0x6) return &OP_6xkk<x, kk>;
+        else if constexpr (group == 0x7) return &OP_7xkk<x, kk>;
+        else if constexpr (group == 0x8) {
+            if constexpr (n == 0x0) return &OP_8xy0<x, y>;
+            else if constexpr (n == 0x1) return &OP_8xy1<x, y>;
+            else if constexpr (n == 0x2) return &OP_8xy2<x, y>;
+            else if constexpr (n == 0x3) return &OP_8xy3<x, y>;
+            else if constexpr (n == 0x4) return &OP_8xy4<x, y>;
+            else if constexpr (n == 0x5) return &OP_8xy5<x, y>;
+            else if constexpr (n == 0x6) return &OP_8xy6<x>;
+            else if constexpr (n == 0x7) return &OP_8xy7<x, y>;
+            else if constexpr (n == 0xE) return &OP_8xyE<x>;
+            else return &OP_NULL;
+        } else if constexpr (group == 0x9) return &OP_9xy0<x, y>;
+        else if constexpr (group == 0xA) return &OP_Annn<nnn>;
+        else if constexpr (group == 0xB) return &OP_Bnnn<nnn>;
+        else if constexpr (group == 0xC) return &OP_Cxkk<x, kk>;
+        else if constexpr (group == 0xD) return &OP_Dxyn<x, y, n>;
+        else if constexpr (group == 0xE) {
+            if constexpr (n == 0xE) return &OP_Ex9E<x>;
+            else if constexpr (n == 0x1) return &OP_ExA1<x>;
+            else return &OP_NULL;
+        } else {
+            if constexpr (kk == 0x07) return &OP_Fx07<x>;
+            else if constexpr (kk == 0x0A) return &OP_Fx0A<x>;
+            else if constexpr (kk == 0x15) return &OP_Fx15<x>;
+            else if constexpr (kk == 0x18) return &OP_Fx18<x>;
+            else if constexpr (kk == 0x1E) return &OP_Fx1E<x>;
+            else if constexpr (kk == 0x29) return &OP_Fx29<x>;
+            else if constexpr (kk == 0x33) return &OP_Fx33<x>;
+            else if constexpr (kk == 0x55) return &OP_Fx55<x>;
+            else if constexpr (kk == 0x65) return &OP_Fx65<x>;
+            else return &OP_NULL;
+        }
+    }
+
+    template<size_t... Opcodes>
+    constexpr array<OpcodeHandler, sizeof...(Opcodes)> MakeTable(index_sequence<Opcodes...>) {
+        return {{HandlerFor<Opcodes>()...}};
+    }
+
+    constexpr array<OpcodeHandler, 0x10000> opcodeTable = MakeTable(make_index_sequence<0x10000>());
+
+}
+
+void RunSpecialized(Chip8 &c, unsigned int cycles) {
+    for (unsigned int i = 0; i < cycles; ++i) {
+        Specialized::opcodeTable[Instructions::Fetch(c)](c);
+        ++c.cycle_count;
+    }
+}
+
+#else
+
+void RunSpecialized(Chip8 &c, unsigned int cycles) {
+    for (unsigned int i = 0; i < cycles; ++i) {
+        c.opcode = Instructions::Fetch(c);
+        (c.*(Chip8::table[c.opcode >> 12u]))();
+        ++c.cycle_count;
+    }
+}
+
+#endif
@@ -0,0 +1,16 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_OPCODETABLE_H
+#define CHIP8_INTERPRETER_OPCODETABLE_H
+
+#include "Chip8.h"
+
+typedef void (*OpcodeHandler)(Chip8 &c);
+
+// Execute instructions through the 64K-entry table of handlers with their operands baked in.
+// Builds with CHIP8_COMPACT_OPCODE_TABLE leave the big table out and use the compact member function tables instead.
+void RunSpecialized(Chip8 &c, unsigned int cycles);
+
+#endif //CHIP8_INTERPRETER_OPCODETABLE_H
@@ -0,0 +1,98 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "PagedMemory.h"
+#include <algorithm>
+#include <cstring>
+
+static shared_ptr<MemoryImage const> const &ZeroImage() {
+    static shared_ptr<MemoryImage const> const zero = make_shared<MemoryImage>();
+    return zero;
+}
+
+PagedMemory::PagedMemory() : PagedMemory(ZeroImage()) {
+}
+
+PagedMemory::PagedMemory(shared_ptr<MemoryImage const> image) : image(std::move(image)) {
+    for (unsigned int page = 0; page < PAGE_COUNT; ++page) {
+        page_bytes[page] = this->image->bytes + page * PAGE_SIZE;
+    }
+}
+
+uint16_t PagedMemory::ReadOpcodeFromPages(uint16_t address) const {
+    unsigned int page = (address / PAGE_SIZE) % PAGE_COUNT;
+    unsigned int first = page;
+    unsigned int last = page;
+    if (!pages[page]) {
+        while (first > 0 && !pages[first - 1]) {
+            --first;
+        }
+        while (last < PAGE_COUNT - 1 && !pages[last + 1]) {
+            ++last;
+        }
+    }
+    fetch_address = first * PAGE_SIZE;
+    fetch_limit = (last - first + 1) * PAGE_SIZE - 1;
+    fetch_bytes = page_bytes[first];
+
+    unsigned int offset = address % PAGE_SIZE;
+    if (offset == PAGE_SIZE - 1) {
+        return (page_bytes[page][offset] << 8u) | Read(address + 1);
+    }
+    return (page_bytes[page][offset] << 8u) | page_bytes[page][offset + 1];
+}
+
+void PagedMemory::Load(uint16_t address, uint8_t *data, size_t length) const {
+    while (length > 0) {
+        address %= SIZE;
+        unsigned int page = address / PAGE_SIZE;
+        unsigned int offset = address % PAGE_SIZE;
+        size_t chunk = std::min<size_t>(length, PAGE_SIZE - offset);
+        std::memcpy(data, page_bytes[page] + offset, chunk);
+        address += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+}
+
+void PagedMemory::Store(uint16_t address, uint8_t const *data, size_t length) {
+    while (length > 0) {
+        address %= SIZE;
+        unsigned int page = address / PAGE_SIZE;
+        unsigned int offset = address % PAGE_SIZE;
+        size_t chunk = std::min<size_t>(length, PAGE_SIZE - offset);
+        if (std::memcmp(page_bytes[page] + offset, data, chunk) != 0) {
+            if (pages[page].use_count() != 1) {
+                MakePrivate(page);
+            }
+            std::memcpy(pages[page]->bytes + offset, data, chunk);
+        }
+        address += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+}
+
+unsigned int PagedMemory::PrivatePages() const {
+    return std::count_if(pages, pages + PAGE_COUNT, [](shared_ptr<MemoryPage> const &page) {
+        return page != nullptr;
+    });
+}
+
+unsigned int PagedMemory::SharedPages(PagedMemory const &other) const {
+    unsigned int shared = 0;
+    for (unsigned int page = 0; page < PAGE_COUNT; ++page) {
+        shared += page_bytes[page] == other.page_bytes[page];
+    }
+    return shared;
+}
+
+void PagedMemory::MakePrivate(unsigned int page) {
+    auto copy = make_shared<MemoryPage>();
+    Load(page * PAGE_SIZE, copy->bytes, PAGE_SIZE);
+    pages[page] = std::move(copy);
+    page_bytes[page] = pages[page]->bytes;
+    // The next fetch finds the page's new bytes
+    fetch_limit = 0;
+}
@@ -0,0 +1,86 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_PAGEDMEMORY_H
+#define CHIP8_INTERPRETER_PAGEDMEMORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+using namespace std;
+
+struct MemoryImage {
+    alignas(64) uint8_t bytes[4096];
+};
+
+struct MemoryPage {
+    alignas(64) uint8_t bytes[256];
+};
+
+// Guest memory as 16 pages of 256 bytes over one immutable image (font and ROM) shared by every instance loaded from
+// it. A page gets a private copy the first time it is written, so instances only own the pages they store to.
+// Private pages are shared in turn by copies of a PagedMemory, and copied again when written while shared.
+// Reads go through a table of page pointers. Instruction fetches skip it while pc stays on the private page or the
+// run of shared pages it was on last time, so the backends that fetch every instruction don't wait for one more load
+// per instruction.
+class PagedMemory {
+public:
+    static constexpr unsigned int SIZE = sizeof(MemoryImage::bytes);
+    static constexpr unsigned int PAGE_SIZE = sizeof(MemoryPage::bytes);
+    static constexpr unsigned int PAGE_COUNT = SIZE / PAGE_SIZE;
+
+    // All zero
+    PagedMemory();
+    explicit PagedMemory(shared_ptr<MemoryImage const> image);
+
+    // Addresses wrap at SIZE
+    uint8_t Read(uint16_t address) const {
+        return page_bytes[(address / PAGE_SIZE) % PAGE_COUNT][address % PAGE_SIZE];
+    }
+
+    // Big-endian instruction at address, the second byte wrapping like the first
+    uint16_t ReadOpcode(uint16_t address) const {
+        uint16_t offset = address - fetch_address;
+        if (offset < fetch_limit) {
+            return (fetch_bytes[offset] << 8u) | fetch_bytes[offset + 1];
+        }
+        return ReadOpcodeFromPages(address);
+    }
+
+    void Write(uint16_t address, uint8_t value) {
+        address %= SIZE;
+        unsigned int page = address / PAGE_SIZE;
+        if (pages[page].use_count() != 1) {
+            MakePrivate(page);
+        }
+        pages[page]->bytes[address % PAGE_SIZE] = value;
+    }
+
+    // Bulk copies, wrapping at SIZE. Store leaves pages it wouldn't change shared.
+    void Load(uint16_t address, uint8_t *data, size_t length) const;
+    void Store(uint16_t address, uint8_t const *data, size_t length);
+
+    // Pages with a copy of their own, shared with copies of this PagedMemory or not
+    unsigned int PrivatePages() const;
+    // Pages this and other read from the same place, e.g. the ones a fork hasn't copied yet
+    unsigned int SharedPages(PagedMemory const &other) const;
+
+private:
+    uint16_t ReadOpcodeFromPages(uint16_t address) const;
+    void MakePrivate(unsigned int page);
+
+    // Contiguous bytes the last instruction was fetched from: its private page, or the run of shared pages around it
+    // in the image. Opcodes at offsets below fetch_limit fit in it.
+    mutable uint16_t fetch_address{};
+    mutable uint16_t fetch_limit{};
+    mutable uint8_t const *fetch_bytes{};
+    // Where each page is read from: the image, or the page's private copy
+    uint8_t const *page_bytes[PAGE_COUNT];
+    shared_ptr<MemoryImage const> image;
+    // Private copies, empty for pages still read from the image
+    shared_ptr<MemoryPage> pages[PAGE_COUNT];
+};
+
+#endif //CHIP8_INTERPRETER_PAGEDMEMORY_H
@@ -6,229 +6,282 @@
 #define CHIP8_INTERPRETER_PLATFORM_H
 
 #include <iostream>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
 #include "SDL.h"
+#include "Input.h"
 using namespace std;
 
+// How frames reach the window
+enum class PresentBackend
+{
+    Renderer,   // Streaming texture drawn by an accelerated SDL renderer, which does the scaling
+    Surface     // Pixels written straight into the window surface, scaled on the CPU; for hosts without a GPU
+};
+
 class Platform
 {
 public:
-    Platform(char const* title, int windowWidth, int windowHeight, int textureWidth, int textureHeight)
+    // Host key for each CHIP-8 key 0-F
+    static constexpr SDL_Keycode KEYMAP[16] =
+    {
+        SDLK_x, SDLK_1, SDLK_2, SDLK_3,
+        SDLK_q, SDLK_w, SDLK_e, SDLK_a,
+        SDLK_s, SDLK_d, SDLK_z, SDLK_c,
+        SDLK_4, SDLK_r, SDLK_f, SDLK_v
+    };
+
+    // In the Surface backend the window surface stands in for the texture, so the texture size is ignored and rows
+    // are window rows
+    Platform(char const* title, int windowWidth, int windowHeight, int textureWidth, int textureHeight,
+             PresentBackend backend = PresentBackend::Renderer)
+        : textureWidth(textureWidth), backend(backend)
     {
         SDL_Init(SDL_INIT_VIDEO);
 
         window = SDL_CreateWindow(title, 0, 0, windowWidth, windowHeight, SDL_WINDOW_SHOWN);
 
-        renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+        wakeEvent = SDL_RegisterEvents(1);
+
+        if (backend == PresentBackend::Surface)
+        {
+            surface = SDL_GetWindowSurface(window);
 
-        texture = SDL_CreateTexture(
-                renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, textureWidth, textureHeight);
+            // The expansion kernels write 32-bit pixels
+            if (!surface || surface->format->BytesPerPixel != 4)
+            {
+                surface = nullptr;
+                this->backend = PresentBackend::Renderer;
+            }
+            else
+            {
+                this->textureWidth = surface->w;
+            }
+        }
+
+        if (this->backend == PresentBackend::Renderer)
+        {
+            renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+
+            texture = SDL_CreateTexture(
+                    renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, textureWidth, textureHeight);
+        }
     }
 
     ~Platform()
     {
-        SDL_DestroyTexture(texture);
-        SDL_DestroyRenderer(renderer);
+        if (texture)
+        {
+            SDL_DestroyTexture(texture);
+        }
+        if (renderer)
+        {
+            SDL_DestroyRenderer(renderer);
+        }
         SDL_DestroyWindow(window);
         SDL_Quit();
     }
 
-    void Update(void const* buffer, int pitch)
+    // Backend actually in use, the Surface backend falls back to Renderer when the window surface isn't 32-bit
+    PresentBackend Backend() const
     {
-        SDL_UpdateTexture(texture, nullptr, buffer, pitch);
-        SDL_RenderClear(renderer);
-        SDL_RenderCopy(renderer, texture, nullptr, nullptr);
-        SDL_RenderPresent(renderer);
+        return backend;
     }
 
-    bool ProcessInput(uint8_t* keys)
+    string BackendName() const
     {
-        bool quit = false;
-
-        SDL_Event event;
-
-        while (SDL_PollEvent(&event))
+        if (backend == PresentBackend::Surface)
         {
-            switch (event.type)
-            {
-                case SDL_QUIT:
-                {
-                    quit = true;
-                } break;
+            return string("surface (") + SDL_GetPixelFormatName(surface->format->format) + ")";
+        }
 
-                case SDL_KEYDOWN:
-                {
-                    switch (event.key.keysym.sym)
-                    {
-                        case SDLK_ESCAPE:
-                        {
-                            quit = true;
-                        } break;
+        SDL_RendererInfo info{};
+        SDL_GetRendererInfo(renderer, &info);
+        return string("renderer (") + (info.name ? info.name : "unknown") + ")";
+    }
 
-                        case SDLK_x:
-                        {
-                            keys[0] = 1;
-                        } break;
+    // RGBA8888 color in the format rows have to be written in
+    uint32_t MapColor(uint32_t rgba) const
+    {
+        if (backend == PresentBackend::Surface)
+        {
+            return SDL_MapRGBA(surface->format, rgba >> 24u, (rgba >> 16u) & 0xFFu, (rgba >> 8u) & 0xFFu, rgba & 0xFFu);
+        }
+        return rgba;
+    }
 
-                        case SDLK_1:
-                        {
-                            keys[1] = 1;
-                        } break;
+    // Upload rowCount texture rows starting at firstRow; buffer points at the first of them. False if they couldn't
+    // be written, e.g. while the window surface can't be locked
+    bool UpdateRows(void const* buffer, int pitch, int firstRow, int rowCount)
+    {
+        if (backend == PresentBackend::Surface)
+        {
+            int surfacePitch;
+            auto pixels = static_cast<uint8_t*>(LockRows(firstRow, rowCount, surfacePitch));
+            if (!pixels)
+            {
+                return false;
+            }
+            for (int row = 0; row < rowCount; ++row)
+            {
+                memcpy(pixels + row * surfacePitch, static_cast<uint8_t const*>(buffer) + row * pitch,
+                       textureWidth * sizeof(uint32_t));
+            }
+            UnlockRows();
+            return true;
+        }
 
-                        case SDLK_2:
-                        {
-                            keys[2] = 1;
-                        } break;
+        SDL_Rect rect{0, firstRow, textureWidth, rowCount};
+        if (SDL_UpdateTexture(texture, &rect, buffer, pitch) != 0)
+        {
+            return false;
+        }
+        needsPresent = true;
+        return true;
+    }
 
-                        case SDLK_3:
-                        {
-                            keys[3] = 1;
-                        } break;
+    // Lock rowCount texture rows starting at firstRow for writing. Locked memory is write-only and has to be filled
+    // completely before UnlockRows()
+    void* LockRows(int firstRow, int rowCount, int& pitch)
+    {
+        SDL_Rect rect{0, firstRow, textureWidth, rowCount};
 
-                        case SDLK_q:
-                        {
-                            keys[4] = 1;
-                        } break;
+        if (backend == PresentBackend::Surface)
+        {
+            if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) != 0)
+            {
+                return nullptr;
+            }
+            dirtyRects.push_back(rect);
+            pitch = surface->pitch;
+            return static_cast<uint8_t*>(surface->pixels) + firstRow * surface->pitch;
+        }
 
-                        case SDLK_w:
-                        {
-                            keys[5] = 1;
-                        } break;
+        void* pixels = nullptr;
+        if (SDL_LockTexture(texture, &rect, &pixels, &pitch) != 0)
+        {
+            return nullptr;
+        }
+        return pixels;
+    }
 
-                        case SDLK_e:
-                        {
-                            keys[6] = 1;
-                        } break;
+    void UnlockRows()
+    {
+        if (backend == PresentBackend::Surface)
+        {
+            if (SDL_MUSTLOCK(surface))
+            {
+                SDL_UnlockSurface(surface);
+            }
+        }
+        else
+        {
+            SDL_UnlockTexture(texture);
+        }
+        needsPresent = true;
+    }
 
-                        case SDLK_a:
-                        {
-                            keys[7] = 1;
-                        } break;
+    // Present only if a row was uploaded or the window needs repainting
+    void Present()
+    {
+        if (!needsPresent)
+        {
+            return;
+        }
 
-                        case SDLK_s:
-                        {
-                            keys[8] = 1;
-                        } break;
+        if (backend == PresentBackend::Surface)
+        {
+            // Only the rows written since the last present, unless the whole window needs repainting
+            if (exposed || dirtyRects.empty())
+            {
+                SDL_UpdateWindowSurface(window);
+            }
+            else
+            {
+                SDL_UpdateWindowSurfaceRects(window, dirtyRects.data(), static_cast<int>(dirtyRects.size()));
+            }
+            dirtyRects.clear();
+        }
+        else
+        {
+            SDL_RenderClear(renderer);
+            SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+            SDL_RenderPresent(renderer);
+        }
+        needsPresent = false;
+        exposed = false;
+    }
 
-                        case SDLK_d:
-                        {
-                            keys[9] = 1;
-                        } break;
+    // Block until an SDL event arrives or timeoutMs passes
+    void WaitForEvent(int timeoutMs)
+    {
+        SDL_WaitEventTimeout(nullptr, timeoutMs);
+    }
 
-                        case SDLK_z:
-                        {
-                            keys[0xA] = 1;
-                        } break;
+    // Thread-safe: end a WaitForEvent() early
+    void WakeUp()
+    {
+        SDL_Event event{};
+        event.type = wakeEvent;
+        SDL_PushEvent(&event);
+    }
 
-                        case SDLK_c:
-                        {
-                            keys[0xB] = 1;
-                        } break;
+    // Queue a timestamped event for every CHIP-8 key that goes down or up; true once the user asks to quit
+    bool ProcessInput(KeyEventQueue& keyEvents)
+    {
+        bool quit = false;
 
-                        case SDLK_4:
-                        {
-                            keys[0xC] = 1;
-                        } break;
+        // Events that didn't fit last time go first, so every key still goes up after it went down
+        while (!pendingKeyEvents.empty() && keyEvents.Push(pendingKeyEvents.front()))
+        {
+            pendingKeyEvents.pop_front();
+        }
 
-                        case SDLK_r:
-                        {
-                            keys[0xD] = 1;
-                        } break;
+        SDL_Event event;
 
-                        case SDLK_f:
-                        {
-                            keys[0xE] = 1;
-                        } break;
+        while (SDL_PollEvent(&event))
+        {
+            switch (event.type)
+            {
+                case SDL_QUIT:
+                {
+                    quit = true;
+                } break;
 
-                        case SDLK_v:
-                        {
-                            keys[0xF] = 1;
-                        } break;
+                case SDL_WINDOWEVENT:
+                {
+                    if (event.window.event == SDL_WINDOWEVENT_EXPOSED || event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+                    {
+                        needsPresent = true;
+                        exposed = true;
                     }
                 } break;
 
+                case SDL_KEYDOWN:
                 case SDL_KEYUP:
                 {
-                    switch (event.key.keysym.sym)
+                    if (event.key.keysym.sym == SDLK_ESCAPE)
                     {
-                        case SDLK_x:
-                        {
-                            keys[0] = 0;
-                        } break;
-
-                        case SDLK_1:
-                        {
-                            keys[1] = 0;
-                        } break;
-
-                        case SDLK_2:
-                        {
-                            keys[2] = 0;
-                        } break;
-
-                        case SDLK_3:
-                        {
-                            keys[3] = 0;
-                        } break;
-
-                        case SDLK_q:
-                        {
-                            keys[4] = 0;
-                        } break;
-
-                        case SDLK_w:
-                        {
-                            keys[5] = 0;
-                        } break;
-
-                        case SDLK_e:
-                        {
-                            keys[6] = 0;
-                        } break;
-
-                        case SDLK_a:
-                        {
-                            keys[7] = 0;
-                        } break;
-
-                        case SDLK_s:
-                        {
-                            keys[8] = 0;
-                        } break;
-
-                        case SDLK_d:
-                        {
-                            keys[9] = 0;
-                        } break;
-
-                        case SDLK_z:
-                        {
-                            keys[0xA] = 0;
-                        } break;
-
-                        case SDLK_c:
-                        {
-                            keys[0xB] = 0;
-                        } break;
-
-                        case SDLK_4:
-                        {
-                            keys[0xC] = 0;
-                        } break;
-
-                        case SDLK_r:
-                        {
-                            keys[0xD] = 0;
-                        } break;
-
-                        case SDLK_f:
-                        {
-                            keys[0xE] = 0;
-                        } break;
+                        quit = true;
+                    }
+                    if (event.key.repeat)
+                    {
+                        break;
+                    }
 
-                        case SDLK_v:
-                        {
-                            keys[0xF] = 0;
-                        } break;
+                    for (uint8_t key = 0; key < 16; ++key)
+                    {
+                        if (event.key.keysym.sym == KEYMAP[key])
+                        {
+                            KeyEvent keyEvent{chrono::steady_clock::now(), key, event.type == SDL_KEYDOWN};
+                            // Held back while the emulator is a thousand events behind
+                            if (!pendingKeyEvents.empty() || !keyEvents.Push(keyEvent))
+                            {
+                                pendingKeyEvents.push_back(keyEvent);
+                            }
+                        }
                     }
                 } break;
             }
@@ -241,6 +294,15 @@ private:
     SDL_Window* window{};
     SDL_Renderer* renderer{};
     SDL_Texture* texture{};
+    SDL_Surface* surface{};
+    int textureWidth;
+    PresentBackend backend;
+    vector<SDL_Rect> dirtyRects;
+    // Key events waiting for room in the queue, oldest first
+    deque<KeyEvent> pendingKeyEvents;
+    Uint32 wakeEvent{};
+    bool needsPresent = true;
+    bool exposed = true;
 };
 
 
@@ -0,0 +1,103 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "PresentBenchmark.h"
+#include "Presenter.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace std;
+
+static const unsigned int DEFAULT_FRAMES = 600;
+static const unsigned int MAX_SCALE = 20;
+
+// Average milliseconds per fully changed frame; with present false only the upload is timed
+static double TimeFrames(Platform &platform, Presenter &presenter, uint64_t *display, unsigned int frames,
+                         bool present) {
+    std::chrono::steady_clock::duration elapsed{};
+    for (unsigned int frame = 0; frame < frames; ++frame) {
+        // Invert the pattern so every row really changes
+        for (unsigned int row = 0; row < 32; ++row) {
+            display[row] = ~display[row];
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        presenter.Upload(display, 0xFFFFFFFF);
+        if (!present) {
+            elapsed += std::chrono::steady_clock::now() - start;
+        }
+        platform.Present();
+        if (present) {
+            elapsed += std::chrono::steady_clock::now() - start;
+        }
+    }
+
+    return std::chrono::duration<double, std::milli>(elapsed).count() / frames;
+}
+
+int RunPresentBenchmark(int argc, char *argv[]) {
+    unsigned int frames = DEFAULT_FRAMES;
+    if (argc > 0) {
+        uint64_t value;
+        if (!ParseCount(argv[0], value) || value == 0 || value > UINT32_MAX) {
+            std::cerr << "Frames must be between 1 and 4294967295\nUsage: --bench-present [Frames]\n";
+            return EXIT_FAILURE;
+        }
+        frames = value;
+    }
+
+    uint64_t display[32];
+    mt19937_64 random(0xC8);
+    for (uint64_t &row: display) {
+        row = random();
+    }
+
+    // Upload only, into a texture of the scaled size
+    std::printf("scale  update ms/frame  lock ms/frame\n");
+    for (unsigned int scale = 1; scale <= MAX_SCALE; ++scale) {
+        unsigned int width = 64 * scale;
+        unsigned int height = 32 * scale;
+        Platform platform("CHIP-8 Present Benchmark", width, height, width, height);
+        ExpandKernel expand = GetExpandKernel(SelectExpandIsa(SDL_HasSSE2(), SDL_HasAVX2()));
+
+        Presenter update(platform, 32, scale, DEFAULT_PALETTE, expand, UploadMode::Update);
+        double updateTime = TimeFrames(platform, update, display, frames, false);
+        Presenter lock(platform, 32, scale, DEFAULT_PALETTE, expand, UploadMode::Lock);
+        double lockTime = TimeFrames(platform, lock, display, frames, false);
+
+        std::printf("%5u  %15.4f  %13.4f\n", scale, updateTime, lockTime);
+    }
+
+    // Whole frames as the frontend presents them: a 64x32 texture scaled by the renderer, or the window surface
+    // filled at window size
+    std::printf("\nscale  renderer ms/frame  surface ms/frame\n");
+    for (unsigned int scale = 1; scale <= MAX_SCALE; ++scale) {
+        unsigned int width = 64 * scale;
+        unsigned int height = 32 * scale;
+        double times[2];
+        string names[2];
+        PresentBackend backends[2] = {PresentBackend::Renderer, PresentBackend::Surface};
+
+        for (int b = 0; b < 2; ++b) {
+            Platform platform("CHIP-8 Present Benchmark", width, height, 64, 32, backends[b]);
+            ExpandKernel expand = GetExpandKernel(SelectExpandIsa(SDL_HasSSE2(), SDL_HasAVX2()));
+            unsigned int presentScale = platform.Backend() == PresentBackend::Surface ? scale : 1;
+            Palette palette = {platform.MapColor(DEFAULT_PALETTE.off), platform.MapColor(DEFAULT_PALETTE.on)};
+
+            Presenter presenter(platform, 32, presentScale, palette, expand, UploadMode::Lock);
+            times[b] = TimeFrames(platform, presenter, display, frames, true);
+            names[b] = platform.BackendName();
+        }
+
+        if (scale == 1) {
+            std::printf("       %s, %s\n", names[0].c_str(), names[1].c_str());
+        }
+        std::printf("%5u  %17.4f  %16.4f\n", scale, times[0], times[1]);
+    }
+
+    return EXIT_SUCCESS;
+}
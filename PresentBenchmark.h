@@ -0,0 +1,12 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_PRESENTBENCHMARK_H
+#define CHIP8_INTERPRETER_PRESENTBENCHMARK_H
+
+// Time expanding and uploading a fully changed frame with each upload mode, at texture scales 1 to 20.
+// Arguments: [Frames]
+int RunPresentBenchmark(int argc, char *argv[]);
+
+#endif //CHIP8_INTERPRETER_PRESENTBENCHMARK_H
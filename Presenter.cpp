@@ -0,0 +1,54 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "Presenter.h"
+
+using namespace std;
+
+static const unsigned int DISPLAY_COLUMNS = 64;
+
+Presenter::Presenter(Platform &platform, unsigned int rows, unsigned int scale, Palette palette, ExpandKernel expand,
+                     UploadMode mode)
+        : platform(platform), rows(rows), scale(scale), palette(palette), expand(expand), mode(mode) {
+}
+
+uint32_t Presenter::Upload(uint64_t const *display, uint32_t dirtyRows) {
+    uint32_t failedRows = 0;
+    // One upload per run of dirty rows
+    for (unsigned int row = 0; row < rows;) {
+        if (!((dirtyRows >> row) & 1u)) {
+            ++row;
+            continue;
+        }
+        unsigned int first = row;
+        while (row < rows && ((dirtyRows >> row) & 1u)) {
+            ++row;
+        }
+        if (!UploadSpan(display, first, row - first)) {
+            failedRows |= (row - first == 32 ? 0xFFFFFFFFu : (1u << (row - first)) - 1u) << first;
+        }
+    }
+    return failedRows;
+}
+
+bool Presenter::UploadSpan(uint64_t const *display, unsigned int first, unsigned int count) {
+    if (mode == UploadMode::Lock) {
+        int pitch;
+        auto pixels = static_cast<uint32_t *>(platform.LockRows(first * scale, count * scale, pitch));
+        if (pixels) {
+            expand(display + first, count, pixels, pitch, scale, palette);
+            platform.UnlockRows();
+            return true;
+        }
+        // Texture can't be locked, copy instead
+    }
+
+    if (staging.empty()) {
+        staging.resize(DISPLAY_COLUMNS * scale * rows * scale);
+    }
+    int pitch = DISPLAY_COLUMNS * scale * sizeof(uint32_t);
+    uint32_t *pixels = &staging[first * scale * DISPLAY_COLUMNS * scale];
+    expand(display + first, count, pixels, pitch, scale, palette);
+    return platform.UpdateRows(pixels, pitch, first * scale, count * scale);
+}
@@ -0,0 +1,40 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_PRESENTER_H
+#define CHIP8_INTERPRETER_PRESENTER_H
+
+#include "Platform.h"
+#include "DisplayExpand.h"
+#include <vector>
+
+// How expanded rows get into the streaming texture
+enum class UploadMode {
+    Update, // Expand into a staging buffer, SDL_UpdateTexture copies it
+    Lock    // Expand straight into SDL_LockTexture memory, one copy fewer
+};
+
+// Expands the dirty rows of the bit-packed display into the platform's texture, whose size must be the display's
+// times scale
+class Presenter {
+public:
+    Presenter(Platform &platform, unsigned int rows, unsigned int scale, Palette palette, ExpandKernel expand,
+              UploadMode mode);
+
+    // Rows that couldn't be uploaded, to be tried again
+    uint32_t Upload(uint64_t const *display, uint32_t dirtyRows);
+
+private:
+    bool UploadSpan(uint64_t const *display, unsigned int first, unsigned int count);
+
+    Platform &platform;
+    unsigned int rows;
+    unsigned int scale;
+    Palette palette;
+    ExpandKernel expand;
+    UploadMode mode;
+    vector<uint32_t> staging;
+};
+
+#endif //CHIP8_INTERPRETER_PRESENTER_H
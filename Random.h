@@ -0,0 +1,47 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_RANDOM_H
+#define CHIP8_INTERPRETER_RANDOM_H
+
+#include <cstdint>
+
+// PCG32 (XSH RR variant, O'Neill 2014): 64-bit LCG state, 32-bit output by xorshift and random rotation.
+// Byte stream: each NextByte() steps the generator once and returns the top 8 bits of that step's 32-bit output.
+// Generators seeded alike but with different streams produce independent sequences.
+class Pcg32 {
+public:
+    static const uint64_t MULTIPLIER = 6364136223846793005ull;
+    static const uint64_t DEFAULT_STREAM = 0xDA3E39CB94B95BDBull;
+
+    Pcg32() {
+        Seed(0);
+    }
+
+    // Same seeding as the reference pcg32_srandom_r(initstate = seed, initseq = stream)
+    void Seed(uint64_t seed, uint64_t stream = DEFAULT_STREAM) {
+        state = 0;
+        increment = (stream << 1u) | 1u;
+        Next();
+        state += seed;
+        Next();
+    }
+
+    uint32_t Next() {
+        uint64_t old = state;
+        state = old * MULTIPLIER + increment;
+        auto xorshifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        uint32_t rotation = old >> 59u;
+        return (xorshifted >> rotation) | (xorshifted << ((32u - rotation) & 31u));
+    }
+
+    uint8_t NextByte() {
+        return Next() >> 24u;
+    }
+
+    uint64_t state{};
+    uint64_t increment{};
+};
+
+#endif //CHIP8_INTERPRETER_RANDOM_H
@@ -0,0 +1,51 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_SPSCQUEUE_H
+#define CHIP8_INTERPRETER_SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+using namespace std;
+
+// Lock-free bounded queue for exactly one producer thread and one consumer thread. Capacity must be a power of two.
+template<typename T, size_t Capacity>
+class SpscQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer: false if the queue is full
+    bool Push(T const &item) {
+        size_t tail = this->tail.load(memory_order_relaxed);
+        if (tail - head.load(memory_order_acquire) == Capacity) {
+            return false;
+        }
+        items[tail & (Capacity - 1)] = item;
+        this->tail.store(tail + 1, memory_order_release);
+        return true;
+    }
+
+    // Consumer: look at the oldest item without removing it, false if the queue is empty
+    bool Peek(T &item) const {
+        size_t head = this->head.load(memory_order_relaxed);
+        if (head == tail.load(memory_order_acquire)) {
+            return false;
+        }
+        item = items[head & (Capacity - 1)];
+        return true;
+    }
+
+    // Consumer: drop the item returned by Peek()
+    void Pop() {
+        head.store(head.load(memory_order_relaxed) + 1, memory_order_release);
+    }
+
+private:
+    T items[Capacity]{};
+    alignas(64) atomic<size_t> head{0};
+    alignas(64) atomic<size_t> tail{0};
+};
+
+#endif //CHIP8_INTERPRETER_SPSCQUEUE_H
@@ -0,0 +1,52 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_TRIPLEBUFFER_H
+#define CHIP8_INTERPRETER_TRIPLEBUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+// Lock-free single producer, single consumer triple buffer. The producer always has a slot to write into and the
+// consumer always reads the newest complete one; neither ever waits for the other. Frames the consumer doesn't get
+// to in time are overwritten.
+template<typename T>
+class TripleBuffer {
+public:
+    // Producer: fill Back(), then Publish() it as the newest frame
+    T &Back() {
+        return slots[back];
+    }
+
+    void Publish() {
+        back = middle.exchange(back | FRESH, memory_order_acq_rel) & INDEX;
+    }
+
+    // Consumer: make the newest published frame Front(), false if nothing was published since the last call
+    bool Update() {
+        if (!(middle.load(memory_order_relaxed) & FRESH)) {
+            return false;
+        }
+        front = middle.exchange(front, memory_order_acq_rel) & INDEX;
+        return true;
+    }
+
+    T const &Front() const {
+        return slots[front];
+    }
+
+private:
+    static const uint8_t INDEX = 0x3;
+    static const uint8_t FRESH = 0x4;
+
+    T slots[3]{};
+    // Slot indices; the middle one is shared, with FRESH set while it holds a frame the consumer hasn't taken
+    alignas(64) uint8_t back = 0;
+    alignas(64) atomic<uint8_t> middle{1};
+    alignas(64) uint8_t front = 2;
+};
+
+#endif //CHIP8_INTERPRETER_TRIPLEBUFFER_H
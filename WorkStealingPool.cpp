@@ -0,0 +1,62 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "WorkStealingPool.h"
+#include <thread>
+
+WorkStealingPool::WorkStealingPool(unsigned int threads) : threads(threads ? threads : 1), queues(this->threads) {
+}
+
+void WorkStealingPool::Run(size_t count, function<void(size_t, unsigned int)> const &job) {
+    // Worker w starts with jobs w, w + threads, ... and runs them in order, popping from the back
+    for (unsigned int w = 0; w < threads; ++w) {
+        queues[w].jobs.clear();
+        for (size_t i = w; i < count; i += threads) {
+            queues[w].jobs.push_front(i);
+        }
+    }
+
+    auto work = [&](unsigned int worker) {
+        size_t next;
+        while (Take(worker, next) || Steal(worker, next)) {
+            job(next, worker);
+        }
+    };
+
+    vector<thread> workers;
+    for (unsigned int w = 1; w < threads; ++w) {
+        workers.emplace_back(work, w);
+    }
+    work(0);
+    for (thread &worker: workers) {
+        worker.join();
+    }
+}
+
+bool WorkStealingPool::Take(unsigned int worker, size_t &job) {
+    Queue &own = queues[worker];
+    lock_guard<mutex> guard(own.lock);
+    if (own.jobs.empty()) {
+        return false;
+    }
+    job = own.jobs.back();
+    own.jobs.pop_back();
+    return true;
+}
+
+// Nothing is ever added once Run has started, so one pass over every other queue finding nothing means all jobs
+// have been handed out
+bool WorkStealingPool::Steal(unsigned int worker, size_t &job) {
+    for (unsigned int i = 1; i < threads; ++i) {
+        Queue &victim = queues[(worker + i) % threads];
+        lock_guard<mutex> guard(victim.lock);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            steals.fetch_add(1, memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,47 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#ifndef CHIP8_INTERPRETER_WORKSTEALINGPOOL_H
+#define CHIP8_INTERPRETER_WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+// Runs a fixed set of jobs on worker threads. Jobs are dealt out round-robin up front; each worker takes from the
+// back of its own deque and, once that is empty, steals from the front of the others, so workers stuck with long
+// jobs hand the rest of their share to idle ones.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(unsigned int threads);
+
+    // Call job(i, worker) once for every i in [0, count) and return when all have finished
+    void Run(size_t count, function<void(size_t job, unsigned int worker)> const &job);
+
+    unsigned int Threads() const {
+        return threads;
+    }
+
+    atomic<uint64_t> steals{0};
+
+private:
+    struct Queue {
+        mutex lock;
+        deque<size_t> jobs;
+    };
+
+    bool Take(unsigned int worker, size_t &job);
+    bool Steal(unsigned int worker, size_t &job);
+
+    unsigned int threads;
+    vector<Queue> queues;
+};
+
+#endif //CHIP8_INTERPRETER_WORKSTEALINGPOOL_H
@@ -0,0 +1,291 @@
+//
+// Created by CubeSky on 18/10/2026.
+//
+
+#include "Chip8.h"
+#include "Benchmark.h"
+#include "Headless.h"
+#include "Footprint.h"
+#ifdef CHIP8_HAVE_SDL
+#include "Presenter.h"
+#include "PresentBenchmark.h"
+#include "TripleBuffer.h"
+#include "Input.h"
+#include "LatencyTracker.h"
+#endif
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+// Seed for --headless and --bench when none is given, so their hashes are reproducible
+static const uint64_t DEFAULT_SEED = 0xC8;
+
+#ifdef CHIP8_HAVE_SDL
+// Longest the SDL thread sleeps without an event, as a safety net
+static const int IDLE_WAIT_MS = 100;
+// Largest window scale accepted, which keeps the window within SDL's size limits
+static const unsigned int MAX_SCALE = 100;
+
+// What the emulation thread hands to the presentation thread
+struct VideoFrame {
+    uint64_t display[32];
+    uint64_t number;
+};
+#endif
+
+static int Usage(char const *program) {
+    std::cerr << "Usage: " << program << " [--seed <N>] <ROM> <Scale> <CyclesPerFrame> <Dispatch> <Palette> <Backend>\n";
+    std::cerr << "       " << program << " [--seed <N>] --latency <File|-> <ROM> <Scale> ...\n";
+    std::cerr << "       " << program << " [--seed <N>] --headless --frames|--instructions <Count> <ROM> <CyclesPerFrame> <Dispatch>\n";
+    std::cerr << "       " << program << " [--seed <N>] --bench <Cycles> <ROM>...\n";
+    std::cerr << "       " << program << " [--seed <N>] --bench-lockstep <Cycles> <ROM>...\n";
+    std::cerr << "       " << program << " [--seed <N>] --bench-fork <Forks> <ROM>...\n";
+    std::cerr << "       " << program << " --bench-present <Frames>\n";
+    std::cerr << "       " << program << " --footprint <Instances>\n";
+    return EXIT_FAILURE;
+}
+
+int main(int argc, char *argv[]) {
+    //spdlog::set_level(spdlog::level::debug);
+    Chip8 chip8;
+
+    // --seed <N> in front of everything else fixes the random number generator, also for the window
+    uint64_t seed = DEFAULT_SEED;
+    if (argc > 2 && string(argv[1]) == "--seed") {
+        if (!ParseSeed(argv[2], seed)) {
+            std::cerr << "Seed must be a decimal or 0x hex number\n";
+            return Usage(argv[0]);
+        }
+        chip8.Seed(seed);
+        argv[2] = argv[0];
+        argc -= 2;
+        argv += 2;
+    }
+
+    if (argc < 2) {
+        return Usage(argv[0]);
+    }
+
+    if (string(argv[1]) == "--bench") {
+        return RunDispatchBenchmark(argc - 2, argv + 2, seed);
+    }
+    if (string(argv[1]) == "--bench-lockstep") {
+        return RunLockstepBenchmark(argc - 2, argv + 2, seed);
+    }
+    if (string(argv[1]) == "--bench-fork") {
+        return RunForkBenchmark(argc - 2, argv + 2, seed);
+    }
+    if (string(argv[1]) == "--footprint") {
+        return RunFootprintReport(argc - 2, argv + 2);
+    }
+    if (string(argv[1]) == "--headless") {
+        return RunHeadless(argc - 2, argv + 2, seed);
+    }
+
+#ifdef CHIP8_HAVE_SDL
+    if (string(argv[1]) == "--bench-present") {
+        return RunPresentBenchmark(argc - 2, argv + 2);
+    }
+
+    // --latency <File|-> in front of the usual arguments traces input-to-photon latency
+    unique_ptr<LatencyTracker> tracker;
+    char const *latency_output = nullptr;
+    if (string(argv[1]) == "--latency" && argc > 3) {
+        tracker = make_unique<LatencyTracker>();
+        chip8.trace_latency = true;
+        latency_output = argv[2];
+        argv[2] = argv[0];
+        argc -= 2;
+        argv += 2;
+    }
+
+    char const *rom_filename = argv[1];
+    unsigned int scale = chip8.DEFAULT_SCALE;
+    unsigned int cyclesPerFrame = chip8.DEFAULT_CYCLES_PER_FRAME;
+
+    uint64_t value;
+    if (argc > 2) {
+        if (!ParseCount(argv[2], value) || value == 0 || value > MAX_SCALE) {
+            std::cerr << "Scale must be between 1 and " << MAX_SCALE << ": " << argv[2] << "\n";
+            std::exit(EXIT_FAILURE);
+        }
+        scale = value;
+    }
+    if (argc > 3) {
+        if (!ParseCount(argv[3], value) || value == 0 || value > Chip8::MAX_CYCLES_PER_FRAME) {
+            std::cerr << "CyclesPerFrame must be between 1 and " << Chip8::MAX_CYCLES_PER_FRAME << ": " << argv[3]
+                      << "\n";
+            std::exit(EXIT_FAILURE);
+        }
+        cyclesPerFrame = value;
+    }
+    chip8.dispatch_mode = DispatchMode::Specialized;
+    if (argc > 4 && !ParseDispatchMode(argv[4], chip8.dispatch_mode)) {
+        std::cerr << "Unknown dispatch mode: " << argv[4] << "\n";
+        std::exit(EXIT_FAILURE);
+    }
+    Palette palette = DEFAULT_PALETTE;
+    if (argc > 5 && !ParsePalette(argv[5], palette)) {
+        std::cerr << "Palette must be RRGGBB:RRGGBB (on:off): " << argv[5] << "\n";
+        std::exit(EXIT_FAILURE);
+    }
+    PresentBackend backend = PresentBackend::Renderer;
+    if (argc > 6) {
+        if (string(argv[6]) == "surface") {
+            backend = PresentBackend::Surface;
+        } else if (string(argv[6]) != "renderer") {
+            std::cerr << "Backend must be renderer or surface: " << argv[6] << "\n";
+            std::exit(EXIT_FAILURE);
+        }
+    }
+
+    Platform platform("CHIP-8 Emulator", chip8.VIDEO_WIDTH * scale, chip8.VIDEO_HEIGHT * scale, chip8.VIDEO_WIDTH,
+                      chip8.VIDEO_HEIGHT, backend);
+    std::cout << "Presenting with " << platform.BackendName() << "\n";
+
+    if (!chip8.LoadROM(rom_filename)) {
+        std::cerr << "Can't read ROM " << rom_filename << "\n";
+        std::exit(EXIT_FAILURE);
+    }
+    chip8.SetClockRate(cyclesPerFrame * chip8.FRAME_RATE);
+    chip8.skip_idle_loops = true;
+
+    // SDL is initialised by now, so its CPU feature checks can pick the expansion kernel
+    ExpandKernel expand = GetExpandKernel(SelectExpandIsa(SDL_HasSSE2(), SDL_HasAVX2()));
+    // The window surface is filled at window size, a texture is scaled up by the renderer
+    unsigned int presentScale = platform.Backend() == PresentBackend::Surface ? scale : 1;
+    palette = {platform.MapColor(palette.off), platform.MapColor(palette.on)};
+    Presenter presenter(platform, chip8.VIDEO_HEIGHT, presentScale, palette, expand, UploadMode::Lock);
+
+    TripleBuffer<VideoFrame> frames;
+    KeyEventQueue keyEvents;
+    atomic<bool> quit{false};
+    // Wakes the emulation thread when it is parked on a key wait
+    mutex inputMutex;
+    condition_variable inputArrived;
+
+    // Emulation thread: each batch of instructions stands for the 60 Hz frame of host time that just ended, so key
+    // events from that frame land on the cycles matching their timestamps. Frames that changed the display are
+    // published.
+    thread emulation([&]() {
+        auto frameDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(1.0 / chip8.FRAME_RATE));
+        auto frameStart = std::chrono::steady_clock::now();
+        uint64_t frameNumber = 0;
+
+        while (!quit.load(memory_order_relaxed)) {
+            // Parked on Fx0A: run nothing and publish nothing until a key event arrives. Whole frames before the
+            // event only advance the clock, exactly as spinning on the wait would have, so timers stay correct.
+            if (chip8.WaitingForKey()) {
+                KeyEvent event{};
+                {
+                    unique_lock<mutex> lock(inputMutex);
+                    inputArrived.wait(lock, [&]() {
+                        return quit.load(memory_order_relaxed) || keyEvents.Peek(event);
+                    });
+                }
+                if (event.time > frameStart) {
+                    auto skippedFrames = (event.time - frameStart) / frameDuration;
+                    chip8.AdvanceClock(skippedFrames * cyclesPerFrame);
+                    frameStart += skippedFrames * frameDuration;
+                }
+            }
+
+            auto frameEnd = frameStart + frameDuration;
+            std::this_thread::sleep_until(frameEnd);
+
+            RunFrameWithInput(chip8, cyclesPerFrame, keyEvents, frameStart, frameDuration, tracker.get());
+
+            if (tracker) {
+                tracker->FrameEnded(chip8, frameNumber + 1);
+            }
+            if (chip8.dirty_rows) {
+                std::memcpy(frames.Back().display, chip8.display, sizeof(chip8.display));
+                frames.Back().number = ++frameNumber;
+                frames.Publish();
+                platform.WakeUp();
+                chip8.dirty_rows = 0;
+            }
+
+            // If we fell behind, resync instead of bursting to catch up
+            frameStart = frameEnd;
+            auto currentTime = std::chrono::steady_clock::now();
+            if (currentTime - frameStart > frameDuration) {
+                frameStart = currentTime - frameDuration;
+            }
+        }
+    });
+
+    // This thread polls input and presents the newest complete frame, never waiting on the emulator. Between frames
+    // it sleeps in SDL until an input event or the emulator's wake-up arrives.
+    uint64_t presented[32]{};
+    bool firstFrame = true;
+    // Rows of the presented frame that didn't make it to the window yet
+    uint32_t staleRows = 0;
+
+    while (!quit.load(memory_order_relaxed)) {
+        if (platform.ProcessInput(keyEvents)) {
+            quit.store(true, memory_order_relaxed);
+        }
+        // Taking the lock orders this after a parked emulation thread's check of the queue, so it can't miss the wake-up
+        {
+            lock_guard<mutex> lock(inputMutex);
+        }
+        inputArrived.notify_one();
+
+        if (!frames.Update()) {
+            if (staleRows) {
+                staleRows = presenter.Upload(frames.Front().display, staleRows);
+            }
+            platform.Present();
+            platform.WaitForEvent(IDLE_WAIT_MS);
+            continue;
+        }
+
+        // Frames in between may have been skipped, so compare against what is on screen rather than trusting the
+        // emulator's dirty rows
+        VideoFrame const &frame = frames.Front();
+        uint32_t dirtyRows = firstFrame ? 0xFFFFFFFF : staleRows;
+        for (unsigned int row = 0; row < chip8.VIDEO_HEIGHT; ++row) {
+            if (frame.display[row] != presented[row]) {
+                dirtyRows |= 1u << row;
+            }
+        }
+        std::memcpy(presented, frame.display, sizeof(presented));
+        firstFrame = false;
+
+        staleRows = presenter.Upload(frame.display, dirtyRows);
+        platform.Present();
+        if (tracker) {
+            tracker->FramePresented(frame.number, std::chrono::steady_clock::now());
+        }
+    }
+
+    emulation.join();
+
+    if (tracker) {
+        if (string(latency_output) == "-") {
+            tracker->Report(stdout, false);
+        } else if (FILE *out = std::fopen(latency_output, "w")) {
+            tracker->Report(out, true);
+            std::fclose(out);
+        } else {
+            std::cerr << "Can't write latency report to " << latency_output << "\n";
+        }
+    }
+
+    return 0;
+#else
+    std::cerr << "Built without SDL2, only --headless and --bench are available\n";
+    return EXIT_FAILURE;
+#endif
+
+}